@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////
+// computemeshes.cpp
+// ============
+// GPU generation of parametric meshes with meshComputeShader.glsl
+//
+//  Each dispatch runs one invocation per vertex (and per grid quad for
+//  indexed shapes).  A memory barrier makes the shader writes visible
+//  to the vertex fetch of the following draw calls.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ComputeMeshes.h"
+#include "RevolutionMeshes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	// must match meshComputeShader.glsl
+	const GLuint g_LocalSize = 64;
+	const GLint g_ShapeTorus = 0;
+	const GLint g_ShapeFrustum = 1;
+
+	// largest difference allowed between the GPU and the CPU
+	// reference, the GPU evaluates each angle with sin/cos
+	const double g_Tolerance = 1.0e-5;
+
+	// size a buffer object without uploading any data
+	void AllocateBuffer(GLuint buffer, GLsizeiptr size)
+	{
+		GLint currentSize = 0;
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glGetBufferParameteriv(GL_COPY_WRITE_BUFFER, GL_BUFFER_SIZE, &currentSize);
+		if (currentSize != size)
+		{
+			glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_STATIC_DRAW);
+		}
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	// run the generator over count work items
+	void Dispatch(GLuint computeProgram, GLuint count)
+	{
+		GLint previousProgram = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+		glUseProgram(computeProgram);
+		glDispatchCompute((count + g_LocalSize - 1) / g_LocalSize, 1, 1);
+		glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+		glUseProgram(previousProgram);
+	}
+
+	// read back a buffer object for validation
+	template <typename T>
+	std::vector<T> ReadBuffer(GLuint buffer, std::size_t count)
+	{
+		std::vector<T> data(count);
+		glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+		glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(T) * count, data.data());
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		return data;
+	}
+
+	// largest absolute difference between two float arrays
+	double MaxDifference(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		double worst = 0.0;
+		for (std::size_t i = 0; i < a.size(); i++)
+		{
+			worst = std::max(worst, std::fabs(double(a[i]) - double(b[i])));
+		}
+		return worst;
+	}
+}
+
+namespace ComputeMeshes
+{
+	GLuint TorusVertexCount(int mainSegments, int tubeSegments)
+	{
+		return (mainSegments + 1) * (tubeSegments + 1);
+	}
+
+	GLuint TorusIndexCount(int mainSegments, int tubeSegments)
+	{
+		return 6 * mainSegments * tubeSegments;
+	}
+
+	GLuint FrustumVertexCount(int segments, bool hasTop)
+	{
+		return (hasTop ? 2 * segments : segments) + 2 * (segments + 1);
+	}
+
+	/***********************************************************
+	 *  GenerateTorus()
+	 *
+	 *  Same layout as RevolutionMeshes::BuildTorus: each main
+	 *  segment is one contiguous run of tube vertices.
+	 ***********************************************************/
+	void GenerateTorus(
+		GLuint computeProgram,
+		int mainSegments,
+		int tubeSegments,
+		float mainRadius,
+		float tubeRadius,
+		GLuint vertexBuffer,
+		GLuint indexBuffer)
+	{
+		GLuint vertexCount = TorusVertexCount(mainSegments, tubeSegments);
+		GLuint indexCount = TorusIndexCount(mainSegments, tubeSegments);
+
+		AllocateBuffer(vertexBuffer, sizeof(GLfloat) * RevolutionMeshes::FloatsPerVertex * vertexCount);
+		AllocateBuffer(indexBuffer, sizeof(GLuint) * indexCount);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertexBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, indexBuffer);
+
+		glProgramUniform1i(computeProgram, glGetUniformLocation(computeProgram, "shape"), g_ShapeTorus);
+		glProgramUniform1i(computeProgram, glGetUniformLocation(computeProgram, "segments"), mainSegments);
+		glProgramUniform1i(computeProgram, glGetUniformLocation(computeProgram, "tubeSegments"), tubeSegments);
+		glProgramUniform1f(computeProgram, glGetUniformLocation(computeProgram, "mainRadius"), mainRadius);
+		glProgramUniform1f(computeProgram, glGetUniformLocation(computeProgram, "radius"), tubeRadius);
+
+		Dispatch(computeProgram, std::max(vertexCount, indexCount / 6));
+	}
+
+	/***********************************************************
+	 *  GenerateFrustum()
+	 *
+	 *  Same layout as RevolutionMeshes::BuildFrustum: the cap
+	 *  rims as triangle fans followed by the sides as one
+	 *  triangle strip.  The index buffer binding is unused.
+	 ***********************************************************/
+	void GenerateFrustum(
+		GLuint computeProgram,
+		int segments,
+		float topRadius,
+		bool hasTop,
+		GLuint vertexBuffer)
+	{
+		GLuint vertexCount = FrustumVertexCount(segments, hasTop);
+
+		AllocateBuffer(vertexBuffer, sizeof(GLfloat) * RevolutionMeshes::FloatsPerVertex * vertexCount);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertexBuffer);
+
+		glProgramUniform1i(computeProgram, glGetUniformLocation(computeProgram, "shape"), g_ShapeFrustum);
+		glProgramUniform1i(computeProgram, glGetUniformLocation(computeProgram, "segments"), segments);
+		glProgramUniform1f(computeProgram, glGetUniformLocation(computeProgram, "radius"), topRadius);
+		glProgramUniform1i(computeProgram, glGetUniformLocation(computeProgram, "bHasTop"), hasTop ? 1 : 0);
+
+		Dispatch(computeProgram, vertexCount);
+	}
+
+	/***********************************************************
+	 *  Validate()
+	 *
+	 *  Generate a few variants of each shape into scratch
+	 *  buffers and compare them with the CPU generators.
+	 ***********************************************************/
+	bool Validate(GLuint computeProgram)
+	{
+		GLuint buffers[2];
+		glGenBuffers(2, buffers);
+
+		bool bPassed = true;
+		RevolutionMeshes::MeshData reference;
+
+		std::cout << "Compute mesh validation (max abs error against the CPU):\n";
+
+		const float tubeRadii[] = { 0.1f, 0.2f, 0.45f };
+		for (float tubeRadius : tubeRadii)
+		{
+			GenerateTorus(computeProgram, 30, 24, 1.0f, tubeRadius, buffers[0], buffers[1]);
+			RevolutionMeshes::BuildTorus(30, 24, 1.0f, tubeRadius, reference);
+
+			std::vector<float> vertices = ReadBuffer<float>(buffers[0], reference.vertices.size());
+			std::vector<std::uint32_t> indices = ReadBuffer<std::uint32_t>(buffers[1], reference.indices.size());
+
+			double error = MaxDifference(vertices, reference.vertices);
+			bool bIndicesMatch = (indices == reference.indices);
+			bPassed = bPassed && (error <= g_Tolerance) && bIndicesMatch;
+
+			std::cout << "  torus 30x24 tube " << tubeRadius << ":  " << error
+				<< (bIndicesMatch ? "" : " (indices differ)") << "\n";
+		}
+
+		const float topRadii[] = { 0.0f, 0.25f, 0.5f, 1.0f };
+		for (float topRadius : topRadii)
+		{
+			bool hasTop = (topRadius > 0.0f);
+			GenerateFrustum(computeProgram, 36, topRadius, hasTop, buffers[0]);
+			RevolutionMeshes::BuildFrustum(36, topRadius, hasTop, reference);
+
+			std::vector<float> vertices = ReadBuffer<float>(buffers[0], reference.vertices.size());
+
+			double error = MaxDifference(vertices, reference.vertices);
+			bPassed = bPassed && (error <= g_Tolerance);
+
+			std::cout << "  frustum 36 top " << topRadius << ":    " << error << "\n";
+		}
+
+		glDeleteBuffers(2, buffers);
+
+		std::cout << (bPassed ? "PASSED" : "FAILED") << std::endl;
+		return(bPassed);
+	}
+}
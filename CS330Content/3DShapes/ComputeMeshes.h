@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// computemeshes.h
+// ============
+// GPU generation of parametric meshes with meshComputeShader.glsl:
+//     torus, cone, cylinder, tapered cylinder
+//
+//  The compute shader writes the interleaved vertices and the indices
+//  straight into the mesh buffer objects, so a new variant of a shape
+//  costs one dispatch and no CPU work or upload.  The layouts are the
+//  same as RevolutionMeshes, which is the CPU reference.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+namespace ComputeMeshes
+{
+	// vertex and index counts of the generated shapes
+	GLuint TorusVertexCount(int mainSegments, int tubeSegments);
+	GLuint TorusIndexCount(int mainSegments, int tubeSegments);
+	GLuint FrustumVertexCount(int segments, bool hasTop);
+
+	// generate a torus around the Z axis into the vertex and index
+	// buffers, which are resized to fit
+	void GenerateTorus(
+		GLuint computeProgram,
+		int mainSegments,
+		int tubeSegments,
+		float mainRadius,
+		float tubeRadius,
+		GLuint vertexBuffer,
+		GLuint indexBuffer);
+
+	// generate a frustum of height 1 and bottom radius 1 into the
+	// vertex buffer, which is resized to fit
+	void GenerateFrustum(
+		GLuint computeProgram,
+		int segments,
+		float topRadius,
+		bool hasTop,
+		GLuint vertexBuffer);
+
+	// compare the generated meshes against the RevolutionMeshes
+	// reference, printed to standard output; returns false when
+	// any difference is larger than the tolerance
+	bool Validate(GLuint computeProgram);
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// levelofdetail.cpp
+// ============
+// choose a level from a mesh LOD chain by its projected screen-space error
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LevelOfDetail.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const float g_Pi = 3.14159265358979f;
+
+	// distance used for objects that contain the camera
+	const float g_NearDistance = 0.1f;
+
+	// the defaults: one pixel of error, 20% hysteresis, and
+	// level changes faded over a quarter second at 60 fps
+	const float g_DefaultErrorThreshold = 1.0f;
+	const float g_DefaultHysteresis = 0.2f;
+	const int g_DefaultFadeFrames = 15;
+}
+
+namespace LevelOfDetail
+{
+	/***********************************************************
+	 *  Selector()
+	 *
+	 *  The default view matches the 7-1 camera and window.
+	 ***********************************************************/
+	Selector::Selector()
+	{
+		m_cameraPosition = glm::vec3(0.0f);
+		m_projectionScale = 0.0f;
+		m_qualityBias = 1.0f;
+		m_errorThreshold = g_DefaultErrorThreshold;
+		m_hysteresis = g_DefaultHysteresis;
+		m_fadeFrames = g_DefaultFadeFrames;
+		SetView(m_cameraPosition, 80.0f, 800.0f);
+	}
+
+	void Selector::SetView(
+		const glm::vec3& cameraPosition,
+		float fieldOfViewDegrees,
+		float viewportHeight)
+	{
+		m_cameraPosition = cameraPosition;
+		m_projectionScale = viewportHeight / (2.0f * std::tan(glm::radians(fieldOfViewDegrees) * 0.5f));
+	}
+
+	void Selector::SetQualityBias(float bias)
+	{
+		m_qualityBias = std::max(bias, 0.01f);
+	}
+
+	void Selector::SetErrorThreshold(float pixels)
+	{
+		m_errorThreshold = std::max(pixels, 0.0f);
+	}
+
+	void Selector::SetHysteresis(float fraction)
+	{
+		m_hysteresis = std::min(std::max(fraction, 0.0f), 0.9f);
+	}
+
+	void Selector::SetFadeFrames(int frames)
+	{
+		m_fadeFrames = std::max(frames, 0);
+	}
+
+	float Selector::PixelsPerUnit(
+		const glm::vec3& center,
+		float radius) const
+	{
+		float distance = glm::length(center - m_cameraPosition) - radius;
+		return(m_projectionScale / std::max(distance, g_NearDistance));
+	}
+
+	int Selector::CoarsestWithin(
+		const std::vector<Level>& levels,
+		float pixelsPerObjectUnit,
+		float thresholdPixels) const
+	{
+		for (int i = (int)levels.size() - 1; i > 0; --i)
+		{
+			if (levels[i].geometricError * pixelsPerObjectUnit <= thresholdPixels)
+			{
+				return(i);
+			}
+		}
+		return(0);
+	}
+
+	/***********************************************************
+	 *  Select()
+	 *
+	 *  An object switches to a finer level as soon as the
+	 *  error of its level is over the threshold, but only
+	 *  switches to a coarser level once that level is under
+	 *  the threshold by the hysteresis fraction.
+	 ***********************************************************/
+	void Selector::Select(
+		ObjectState& state,
+		const std::vector<Level>& levels,
+		const glm::vec3& center,
+		float radius,
+		float worldScale)
+	{
+		if (levels.empty())
+		{
+			return;
+		}
+
+		float pixelsPerObjectUnit = PixelsPerUnit(center, radius) * worldScale;
+		float threshold = m_errorThreshold * m_qualityBias;
+
+		int level = CoarsestWithin(levels, pixelsPerObjectUnit, threshold);
+		if ((state.level >= 0) && (level >= state.level))
+		{
+			int relaxed = CoarsestWithin(levels, pixelsPerObjectUnit, threshold * (1.0f - m_hysteresis));
+			level = std::max(std::min(state.level, (int)levels.size() - 1), relaxed);
+		}
+
+		if (state.level < 0)
+		{
+			state.level = level;
+		}
+		else if (level != state.level)
+		{
+			// a change during a fade restarts it from the level shown
+			state.previousLevel = (m_fadeFrames > 0) ? state.level : -1;
+			state.level = level;
+			state.fade = 0.0f;
+		}
+
+		if (state.previousLevel >= 0)
+		{
+			state.fade += 1.0f / m_fadeFrames;
+			if (state.fade >= 1.0f)
+			{
+				state.previousLevel = -1;
+			}
+		}
+		if (state.previousLevel < 0)
+		{
+			state.fade = 1.0f;
+		}
+
+		m_frameStats.objects++;
+		m_frameStats.trianglesFull += levels[0].triangles;
+		m_frameStats.trianglesDrawn += levels[state.level].triangles;
+		if (state.previousLevel >= 0)
+		{
+			m_frameStats.trianglesDrawn += levels[state.previousLevel].triangles;
+		}
+	}
+
+	void Selector::BeginFrame()
+	{
+		m_frameStats = FrameStats();
+	}
+
+	float ChordError(int segments)
+	{
+		return(1.0f - std::cos(g_Pi / std::max(segments, 1)));
+	}
+}
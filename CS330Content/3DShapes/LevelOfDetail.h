@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// levelofdetail.h
+// ============
+// choose a level from a mesh LOD chain by its projected screen-space error
+//
+//  The geometric error of a level (how far its surface is from the true
+//  surface) is projected with the camera field of view and the viewport
+//  height, and the coarsest level whose error stays under a pixel
+//  threshold is used.  Hysteresis keeps objects near the threshold from
+//  switching back and forth, and a level change can be dither-faded over
+//  a few frames instead of popping.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace LevelOfDetail
+{
+	// one level of a LOD chain, chains are ordered from the
+	// finest level (0) to the coarsest
+	struct Level
+	{
+		float geometricError;	// object space distance to the true surface
+		unsigned int triangles;	// triangles drawn for the level
+	};
+
+	// per object selection state, kept between frames
+	struct ObjectState
+	{
+		int level = -1;			// level shown, -1 before the first frame
+		int previousLevel = -1;	// level fading out, -1 when not fading
+		float fade = 1.0f;		// visible fraction of the new level
+	};
+
+	// triangle counts for the objects selected in one frame
+	struct FrameStats
+	{
+		unsigned int objects = 0;
+		unsigned int trianglesDrawn = 0;
+		unsigned int trianglesFull = 0;	// triangles at the finest levels
+
+		// negative when fading costs more triangles than were saved
+		int TrianglesSaved() const { return (int)trianglesFull - (int)trianglesDrawn; }
+	};
+
+	/***********************************************************
+	 *  Selector
+	 *
+	 *  This class projects the error of LOD levels to the
+	 *  screen and chooses the level to draw for each object.
+	 ***********************************************************/
+	class Selector
+	{
+	public:
+		// constructor
+		Selector();
+
+		// set the camera for the frame, the field of view is the
+		// vertical angle in degrees (Camera::Zoom)
+		void SetView(
+			const glm::vec3& cameraPosition,
+			float fieldOfViewDegrees,
+			float viewportHeight);
+
+		// scale the allowed screen-space error, values above 1
+		// draw coarser levels for more throughput on weak hardware
+		void SetQualityBias(float bias);
+		float GetQualityBias() const { return m_qualityBias; }
+
+		// allowed projected error in pixels at a quality bias of 1
+		void SetErrorThreshold(float pixels);
+		// fraction under the threshold needed to switch coarser
+		void SetHysteresis(float fraction);
+		// frames for a dither fade between levels, 0 to switch at once
+		void SetFadeFrames(int frames);
+
+		// pixels on the screen for one world unit at the nearest
+		// point of the bounding sphere
+		float PixelsPerUnit(
+			const glm::vec3& center,
+			float radius) const;
+
+		// update the state of an object and choose its level, the
+		// world scale converts the object space error of the chain
+		void Select(
+			ObjectState& state,
+			const std::vector<Level>& levels,
+			const glm::vec3& center,
+			float radius,
+			float worldScale);
+
+		// reset the statistics at the start of a frame
+		void BeginFrame();
+		const FrameStats& GetFrameStats() const { return m_frameStats; }
+
+	private:
+		glm::vec3 m_cameraPosition;
+		float m_projectionScale;	// viewport height / (2 tan(fov / 2))
+		float m_qualityBias;
+		float m_errorThreshold;
+		float m_hysteresis;
+		int m_fadeFrames;
+		FrameStats m_frameStats;
+
+		// coarsest level whose projected error is within the threshold
+		int CoarsestWithin(
+			const std::vector<Level>& levels,
+			float pixelsPerObjectUnit,
+			float thresholdPixels) const;
+	};
+
+	// geometric error of a circle approximated by a polygon with
+	// the passed in number of segments, relative to the radius
+	float ChordError(int segments);
+}
@@ -0,0 +1,492 @@
+///////////////////////////////////////////////////////////////////////////////
+// revolutionmeshes.cpp
+// ============
+// runtime generation of surfaces of revolution:
+//     cone, cylinder, tapered cylinder, sphere, torus
+//
+//  The sweep angles come from a unit-circle table built once per mesh,
+//  so there are no sin/cos calls per vertex and no angle accumulated
+//  by repeated float addition.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RevolutionMeshes.h"
+#include "ShapeTables.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REVOLUTION_MESHES_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+	const double g_Pi = 3.14159265358979323846;
+
+	/***********************************************************
+	 *  WriteVertex()
+	 *
+	 *  Scalar emission of one swept vertex, used for the
+	 *  remainder that does not fill a full SSE register.
+	 ***********************************************************/
+	void WriteVertex(
+		float* dst,
+		const RevolutionMeshes::Basis& basis,
+		float c, float s,
+		float r, float a, float nr, float na,
+		float u, float v)
+	{
+		float dx = c * basis.u[0] + s * basis.v[0];
+		float dy = c * basis.u[1] + s * basis.v[1];
+		float dz = c * basis.u[2] + s * basis.v[2];
+
+		dst[0] = r * dx + a * basis.w[0];
+		dst[1] = r * dy + a * basis.w[1];
+		dst[2] = r * dz + a * basis.w[2];
+		dst[3] = nr * dx + na * basis.w[0];
+		dst[4] = nr * dy + na * basis.w[1];
+		dst[5] = nr * dz + na * basis.w[2];
+		dst[6] = u;
+		dst[7] = v;
+	}
+
+	/***********************************************************
+	 *  BuildNaiveTorus()
+	 *
+	 *  The previous torus generation strategy, kept only as the
+	 *  baseline for the benchmark: a sin/cos call per vertex,
+	 *  angles accumulated by float addition, and one vector per
+	 *  ring.
+	 ***********************************************************/
+	std::size_t BuildNaiveTorus(int mainSegments, int tubeSegments, float mainRadius, float tubeRadius, std::vector<float>& out)
+	{
+		float mainStep = float(2.0 * g_Pi / mainSegments);
+		float tubeStep = float(2.0 * g_Pi / tubeSegments);
+		std::vector<std::vector<float>> rings;
+
+		float mainAngle = 0.0f;
+		for (int i = 0; i <= mainSegments; i++)
+		{
+			std::vector<float> ring;
+			float tubeAngle = 0.0f;
+			for (int j = 0; j <= tubeSegments; j++)
+			{
+				float cm = std::cos(mainAngle), sm = std::sin(mainAngle);
+				float ct = std::cos(tubeAngle), st = std::sin(tubeAngle);
+				float radial = mainRadius + tubeRadius * ct;
+				float vertex[8] = {
+					radial * cm, radial * sm, tubeRadius * st,
+					ct * cm, ct * sm, st,
+					float(i) / mainSegments, float(j) / tubeSegments };
+				ring.insert(ring.end(), vertex, vertex + 8);
+				tubeAngle += tubeStep;
+			}
+			rings.push_back(ring);
+			mainAngle += mainStep;
+		}
+
+		out.clear();
+		for (const auto& ring : rings)
+		{
+			out.insert(out.end(), ring.begin(), ring.end());
+		}
+		return out.size() / 8;
+	}
+
+	// largest absolute difference between two float arrays
+	double MaxDifference(const float* a, const float* b, std::size_t count)
+	{
+		double worst = 0.0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			worst = std::max(worst, std::fabs(double(a[i]) - double(b[i])));
+		}
+		return worst;
+	}
+}
+
+namespace RevolutionMeshes
+{
+	/***********************************************************
+	 *  Profile::Add()
+	 *
+	 *  Append a point to the profile.
+	 ***********************************************************/
+	void Profile::Add(float r, float a, float nr, float na, float t)
+	{
+		radial.push_back(r);
+		axial.push_back(a);
+		normalRadial.push_back(nr);
+		normalAxial.push_back(na);
+		texCoord.push_back(t);
+	}
+
+	/***********************************************************
+	 *  BuildUnitCircle()
+	 *
+	 *  Fill the table with the cosine and sine of each segment
+	 *  angle.  Only the step is evaluated with sin/cos; every
+	 *  entry after that is a rotation of the previous one in
+	 *  double precision, which keeps the error far below float
+	 *  precision for any practical segment count.
+	 ***********************************************************/
+	void BuildUnitCircle(int segments, double startAngle, UnitCircle& circle)
+	{
+		circle.segments = segments;
+		circle.cosines.resize(segments + 1);
+		circle.sines.resize(segments + 1);
+
+		double step = 2.0 * g_Pi / segments;
+		double stepCos = std::cos(step);
+		double stepSin = std::sin(step);
+		double c = std::cos(startAngle);
+		double s = std::sin(startAngle);
+
+		for (int i = 0; i < segments; i++)
+		{
+			circle.cosines[i] = float(c);
+			circle.sines[i] = float(s);
+
+			double next = c * stepCos - s * stepSin;
+			s = s * stepCos + c * stepSin;
+			c = next;
+		}
+
+		// close the seam exactly
+		circle.cosines[segments] = circle.cosines[0];
+		circle.sines[segments] = circle.sines[0];
+	}
+
+	/***********************************************************
+	 *  SweepProfile()
+	 *
+	 *  Place every profile point at every angle of the unit
+	 *  circle.  With SSE, four angles are processed at once and
+	 *  transposed into the interleaved vertex layout.
+	 ***********************************************************/
+	void SweepProfile(
+		const Profile& profile,
+		const UnitCircle& circle,
+		const Basis& basis,
+		float* out,
+		std::size_t first,
+		std::size_t profileStride,
+		std::size_t sweepStride)
+	{
+		const std::size_t sweepPoints = circle.cosines.size();
+		const float* cosines = circle.cosines.data();
+		const float* sines = circle.sines.data();
+		const float invSegments = 1.0f / float(circle.segments);
+
+		for (std::size_t p = 0; p < profile.Size(); p++)
+		{
+			const float r = profile.radial[p];
+			const float a = profile.axial[p];
+			const float nr = profile.normalRadial[p];
+			const float na = profile.normalAxial[p];
+			const float v = profile.texCoord[p];
+			float* row = out + (first + p * profileStride) * FloatsPerVertex;
+
+			std::size_t j = 0;
+#ifdef REVOLUTION_MESHES_SSE
+			const __m128 r4 = _mm_set1_ps(r);
+			const __m128 nr4 = _mm_set1_ps(nr);
+			const __m128 step4 = _mm_set1_ps(invSegments);
+			const __m128 ux = _mm_set1_ps(basis.u[0]), uy = _mm_set1_ps(basis.u[1]), uz = _mm_set1_ps(basis.u[2]);
+			const __m128 vx = _mm_set1_ps(basis.v[0]), vy = _mm_set1_ps(basis.v[1]), vz = _mm_set1_ps(basis.v[2]);
+			// the axial parts are the same for every angle
+			const __m128 apx = _mm_set1_ps(a * basis.w[0]), apy = _mm_set1_ps(a * basis.w[1]), apz = _mm_set1_ps(a * basis.w[2]);
+			const __m128 anx = _mm_set1_ps(na * basis.w[0]), any = _mm_set1_ps(na * basis.w[1]), anz = _mm_set1_ps(na * basis.w[2]);
+
+			for (; j + 4 <= sweepPoints; j += 4)
+			{
+				__m128 c = _mm_loadu_ps(cosines + j);
+				__m128 s = _mm_loadu_ps(sines + j);
+
+				// direction away from the axis for the 4 angles
+				__m128 dx = _mm_add_ps(_mm_mul_ps(c, ux), _mm_mul_ps(s, vx));
+				__m128 dy = _mm_add_ps(_mm_mul_ps(c, uy), _mm_mul_ps(s, vy));
+				__m128 dz = _mm_add_ps(_mm_mul_ps(c, uz), _mm_mul_ps(s, vz));
+
+				__m128 px = _mm_add_ps(_mm_mul_ps(r4, dx), apx);
+				__m128 py = _mm_add_ps(_mm_mul_ps(r4, dy), apy);
+				__m128 pz = _mm_add_ps(_mm_mul_ps(r4, dz), apz);
+				__m128 nx = _mm_add_ps(_mm_mul_ps(nr4, dx), anx);
+				__m128 ny = _mm_add_ps(_mm_mul_ps(nr4, dy), any);
+				__m128 nz = _mm_add_ps(_mm_mul_ps(nr4, dz), anz);
+				__m128 u = _mm_mul_ps(_mm_set_ps(float(j + 3), float(j + 2), float(j + 1), float(j)), step4);
+				__m128 tv = _mm_set1_ps(v);
+
+				// transpose into one (px, py, pz, nx) and one (ny, nz, u, v)
+				// register per vertex, then store each vertex in place
+				_MM_TRANSPOSE4_PS(px, py, pz, nx);
+				_MM_TRANSPOSE4_PS(ny, nz, u, tv);
+
+				float* dst = row + j * sweepStride * FloatsPerVertex;
+				const std::size_t next = sweepStride * FloatsPerVertex;
+				_mm_storeu_ps(dst, px);
+				_mm_storeu_ps(dst + 4, ny);
+				_mm_storeu_ps(dst + next, py);
+				_mm_storeu_ps(dst + next + 4, nz);
+				_mm_storeu_ps(dst + 2 * next, pz);
+				_mm_storeu_ps(dst + 2 * next + 4, u);
+				_mm_storeu_ps(dst + 3 * next, nx);
+				_mm_storeu_ps(dst + 3 * next + 4, tv);
+			}
+#endif
+			for (; j < sweepPoints; j++)
+			{
+				WriteVertex(
+					row + j * sweepStride * FloatsPerVertex,
+					basis, cosines[j], sines[j],
+					r, a, nr, na,
+					float(j) * invSegments, v);
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  AppendGridIndices()
+	 *
+	 *  Append two triangles for every quad of the swept grid.
+	 *  The outer loop runs over the larger stride so the
+	 *  indices follow the vertex memory order; for the sphere
+	 *  and torus the first half of the indices then covers
+	 *  exactly half of the surface.
+	 ***********************************************************/
+	void AppendGridIndices(
+		std::size_t profilePoints,
+		std::size_t sweepPoints,
+		std::size_t first,
+		std::size_t profileStride,
+		std::size_t sweepStride,
+		std::vector<std::uint32_t>& indices)
+	{
+		bool profileOuter = profileStride > sweepStride;
+		std::size_t outerCount = profileOuter ? profilePoints : sweepPoints;
+		std::size_t innerCount = profileOuter ? sweepPoints : profilePoints;
+		std::size_t outerStride = profileOuter ? profileStride : sweepStride;
+		std::size_t innerStride = profileOuter ? sweepStride : profileStride;
+
+		std::size_t start = indices.size();
+		indices.resize(start + (outerCount - 1) * (innerCount - 1) * 6);
+		std::uint32_t* dst = indices.data() + start;
+
+		for (std::size_t o = 0; o + 1 < outerCount; o++)
+		{
+			for (std::size_t i = 0; i + 1 < innerCount; i++)
+			{
+				std::uint32_t a = std::uint32_t(first + o * outerStride + i * innerStride);
+				std::uint32_t b = std::uint32_t(a + outerStride);
+				std::uint32_t c = std::uint32_t(b + innerStride);
+				std::uint32_t d = std::uint32_t(a + innerStride);
+
+				dst[0] = a;
+				dst[1] = b;
+				dst[2] = d;
+				dst[3] = d;
+				dst[4] = b;
+				dst[5] = c;
+				dst += 6;
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  BuildFrustum()
+	 *
+	 *  Generate a frustum of height 1 with a bottom radius of 1,
+	 *  laid out like ShapeTables::MakeFrustum: the cap rims as
+	 *  triangle fans followed by the sides as one triangle strip.
+	 ***********************************************************/
+	void BuildFrustum(int segments, float topRadius, bool hasTop, MeshData& mesh)
+	{
+		std::size_t topStart = segments;
+		std::size_t sideStart = topStart + (hasTop ? segments : 0);
+		std::size_t vertexCount = sideStart + 2 * (segments + 1);
+
+		mesh.vertices.resize(vertexCount * FloatsPerVertex);
+		mesh.indices.clear();
+
+		UnitCircle circle;
+		BuildUnitCircle(segments, 0.0, circle);
+
+		// angle t is placed at (cos t, y, -sin t)
+		const Basis basis = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f } };
+
+		// the caps use a disc texture mapping, so they are written directly
+		for (int i = 0; i < segments; i++)
+		{
+			float c = circle.cosines[i];
+			float s = circle.sines[i];
+			float u = 0.5f - 0.5f * s;
+			float v = 0.5f + 0.5f * c;
+
+			WriteVertex(&mesh.vertices[i * FloatsPerVertex], basis, c, s, 1.0f, 0.0f, 0.0f, -1.0f, u, v);
+			if (hasTop)
+			{
+				WriteVertex(&mesh.vertices[(topStart + i) * FloatsPerVertex], basis, c, s, topRadius, 1.0f, 0.0f, 1.0f, u, v);
+			}
+		}
+
+		float slope = 1.0f - topRadius;
+		float normalScale = 1.0f / std::sqrt(1.0f + slope * slope);
+
+		Profile side;
+		side.Add(topRadius, 1.0f, normalScale, slope * normalScale, 1.0f);
+		side.Add(1.0f, 0.0f, normalScale, slope * normalScale, 0.0f);
+
+		SweepProfile(side, circle, basis, mesh.vertices.data(), sideStart, 1, 2);
+	}
+
+	/***********************************************************
+	 *  BuildSphere()
+	 *
+	 *  Generate a unit sphere with rows from the top pole to
+	 *  the bottom pole, laid out like ShapeTables::MakeSphereVertices.
+	 ***********************************************************/
+	void BuildSphere(int stacks, int slices, MeshData& mesh)
+	{
+		std::size_t rowLength = slices + 1;
+
+		mesh.vertices.resize((stacks + 1) * rowLength * FloatsPerVertex);
+		mesh.indices.clear();
+
+		// the polar angles are half of a unit circle with twice the stacks
+		UnitCircle polar;
+		BuildUnitCircle(2 * stacks, 0.0, polar);
+
+		Profile meridian;
+		for (int stack = 0; stack <= stacks; stack++)
+		{
+			float ring = (stack == stacks) ? 0.0f : polar.sines[stack];
+			float y = polar.cosines[stack];
+			meridian.Add(ring, y, ring, y, 1.0f - float(stack) / stacks);
+		}
+
+		UnitCircle azimuth;
+		BuildUnitCircle(slices, -g_Pi, azimuth);
+
+		// the seam sits at the back of the sphere: angle t is placed at (sin t, y, cos t)
+		const Basis basis = { { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+
+		SweepProfile(meridian, azimuth, basis, mesh.vertices.data(), 0, rowLength, 1);
+		AppendGridIndices(stacks + 1, rowLength, 0, rowLength, 1, mesh.indices);
+	}
+
+	/***********************************************************
+	 *  BuildTorus()
+	 *
+	 *  Generate a torus around the Z axis.  The tube circle is
+	 *  the profile and the main circle is the sweep, so each
+	 *  main segment is one contiguous run of vertices.
+	 ***********************************************************/
+	void BuildTorus(int mainSegments, int tubeSegments, float mainRadius, float tubeRadius, MeshData& mesh)
+	{
+		std::size_t tubePoints = tubeSegments + 1;
+
+		mesh.vertices.resize((mainSegments + 1) * tubePoints * FloatsPerVertex);
+		mesh.indices.clear();
+
+		UnitCircle tube;
+		BuildUnitCircle(tubeSegments, 0.0, tube);
+
+		Profile section;
+		for (std::size_t k = 0; k < tubePoints; k++)
+		{
+			float c = tube.cosines[k];
+			float s = tube.sines[k];
+			section.Add(mainRadius + tubeRadius * c, tubeRadius * s, c, s, float(k) / tubeSegments);
+		}
+
+		UnitCircle main;
+		BuildUnitCircle(mainSegments, 0.0, main);
+
+		// angle t is placed at (cos t, sin t, z)
+		const Basis basis = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+
+		SweepProfile(section, main, basis, mesh.vertices.data(), 0, 1, tubePoints);
+		AppendGridIndices(tubePoints, mainSegments + 1, 0, 1, tubePoints, mesh.indices);
+	}
+
+	/***********************************************************
+	 *  RunBenchmark()
+	 *
+	 *  Report the accuracy of the generators against the
+	 *  compile-time tables and a double precision torus, and
+	 *  the torus throughput against the previous per-vertex
+	 *  sin/cos strategy.
+	 ***********************************************************/
+	void RunBenchmark()
+	{
+		MeshData mesh;
+
+		std::cout << "Revolution mesh accuracy (max abs error):\n";
+
+		BuildFrustum(36, 0.0f, false, mesh);
+		std::cout << "  cone 36:              " << MaxDifference(mesh.vertices.data(), ShapeTables::Cone<36>.data(), mesh.vertices.size()) << "\n";
+		BuildFrustum(36, 1.0f, true, mesh);
+		std::cout << "  cylinder 36:          " << MaxDifference(mesh.vertices.data(), ShapeTables::Cylinder<36>.data(), mesh.vertices.size()) << "\n";
+		BuildFrustum(36, 0.5f, true, mesh);
+		std::cout << "  tapered cylinder 36:  " << MaxDifference(mesh.vertices.data(), ShapeTables::TaperedCylinder<36>.data(), mesh.vertices.size()) << "\n";
+		BuildSphere(16, 32, mesh);
+		std::cout << "  sphere 16x32:         " << MaxDifference(mesh.vertices.data(), ShapeTables::SphereVertices<16, 32>.data(), mesh.vertices.size()) << "\n";
+
+		// the torus is checked against a direct double precision evaluation
+		const int mainSegments = 256;
+		const int tubeSegments = 256;
+		BuildTorus(mainSegments, tubeSegments, 1.0f, 0.2f, mesh);
+		std::vector<float> exact(mesh.vertices.size());
+		for (int i = 0; i <= mainSegments; i++)
+		{
+			for (int k = 0; k <= tubeSegments; k++)
+			{
+				double t = 2.0 * g_Pi * (i % mainSegments) / mainSegments;
+				double p = 2.0 * g_Pi * (k % tubeSegments) / tubeSegments;
+				double radial = 1.0 + 0.2 * std::cos(p);
+				float* dst = &exact[(i * (tubeSegments + 1) + k) * FloatsPerVertex];
+				dst[0] = float(radial * std::cos(t));
+				dst[1] = float(radial * std::sin(t));
+				dst[2] = float(0.2 * std::sin(p));
+				dst[3] = float(std::cos(p) * std::cos(t));
+				dst[4] = float(std::cos(p) * std::sin(t));
+				dst[5] = float(std::sin(p));
+				dst[6] = float(i) / mainSegments;
+				dst[7] = float(k) / tubeSegments;
+			}
+		}
+		std::cout << "  torus 256x256:        " << MaxDifference(mesh.vertices.data(), exact.data(), exact.size()) << "\n";
+
+		std::vector<float> naive;
+		BuildNaiveTorus(mainSegments, tubeSegments, 1.0f, 0.2f, naive);
+		std::cout << "  naive torus 256x256:  " << MaxDifference(naive.data(), exact.data(), exact.size()) << "\n";
+
+		// throughput
+		const int repeats = 50;
+		std::size_t vertices = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; r++)
+		{
+			vertices += BuildNaiveTorus(mainSegments, tubeSegments, 1.0f, 0.2f, naive);
+		}
+		double naiveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; r++)
+		{
+			BuildTorus(mainSegments, tubeSegments, 1.0f, 0.2f, mesh);
+		}
+		double sweepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << "Torus throughput (" << repeats << " x " << mainSegments << "x" << tubeSegments << "):\n";
+		std::cout << "  per-vertex sin/cos:   " << (vertices / naiveSeconds) / 1.0e6 << " Mverts/s\n";
+		std::cout << "  unit circle sweep:    " << (vertices / sweepSeconds) / 1.0e6 << " Mverts/s"
+#ifdef REVOLUTION_MESHES_SSE
+			<< " (SSE)"
+#endif
+			<< std::endl;
+	}
+}
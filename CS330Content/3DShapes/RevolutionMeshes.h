@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// revolutionmeshes.h
+// ============
+// runtime generation of surfaces of revolution:
+//     cone, cylinder, tapered cylinder, sphere, torus
+//
+//  A 2D profile is swept around an axis.  The cosine and sine of every
+//  sweep angle are computed once into a unit-circle table that is
+//  reused by every ring, and the vertices are written into one flat,
+//  interleaved array (position, normal, texture coords) four at a time
+//  with SSE when it is available.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RevolutionMeshes
+{
+	// number of interleaved floats for each vertex
+	const std::size_t FloatsPerVertex = 8;
+
+	// generated vertex and index data, ready to upload
+	struct MeshData
+	{
+		std::vector<float> vertices;
+		std::vector<std::uint32_t> indices;
+
+		std::size_t VertexCount() const { return vertices.size() / FloatsPerVertex; }
+	};
+
+	// cosine and sine of segments + 1 evenly spaced angles over a full
+	// turn, the last entry repeats the first for the texture seam
+	struct UnitCircle
+	{
+		int segments;
+		std::vector<float> cosines;
+		std::vector<float> sines;
+	};
+
+	// points along the 2D profile that is swept around the axis, stored
+	// as a structure of arrays
+	struct Profile
+	{
+		std::vector<float> radial;			// distance from the axis
+		std::vector<float> axial;			// position along the axis
+		std::vector<float> normalRadial;	// normal component away from the axis
+		std::vector<float> normalAxial;		// normal component along the axis
+		std::vector<float> texCoord;		// texture coordinate along the profile
+
+		void Add(float r, float a, float nr, float na, float t);
+		std::size_t Size() const { return radial.size(); }
+	};
+
+	// orientation of the sweep: a point at angle t is placed at
+	// radial * (cos(t) * u + sin(t) * v) + axial * w
+	struct Basis
+	{
+		float u[3];
+		float v[3];
+		float w[3];
+	};
+
+	// fill the unit circle table, using a rotation recurrence evaluated
+	// in double precision instead of a sin/cos call per entry
+	void BuildUnitCircle(int segments, double startAngle, UnitCircle& circle);
+
+	// sweep the profile around the axis, writing vertex (p, j) to
+	// out + (first + p * profileStride + j * sweepStride) * FloatsPerVertex
+	void SweepProfile(
+		const Profile& profile,
+		const UnitCircle& circle,
+		const Basis& basis,
+		float* out,
+		std::size_t first,
+		std::size_t profileStride,
+		std::size_t sweepStride);
+
+	// append triangle list indices for a swept grid, in memory order
+	void AppendGridIndices(
+		std::size_t profilePoints,
+		std::size_t sweepPoints,
+		std::size_t first,
+		std::size_t profileStride,
+		std::size_t sweepStride,
+		std::vector<std::uint32_t>& indices);
+
+	// the revolution surfaces, the frustum and sphere use the same layout
+	// as the compile-time tables in ShapeTables.h
+	void BuildFrustum(int segments, float topRadius, bool hasTop, MeshData& mesh);
+	void BuildSphere(int stacks, int slices, MeshData& mesh);
+	void BuildTorus(int mainSegments, int tubeSegments, float mainRadius, float tubeRadius, MeshData& mesh);
+
+	// compare the generators against reference data for accuracy and
+	// report their throughput, printed to standard output
+	void RunBenchmark();
+}
@@ -14,6 +14,11 @@
 
 #include <glm/glm.hpp>
 
+#include "LevelOfDetail.h"
+#include "RevolutionMeshes.h"
+
+#include <vector>
+
 /***********************************************************
  *  ShapeMeshes
  *
@@ -31,10 +36,10 @@ private:
 	// stores the GL data relative to a given mesh
 	struct GLMesh
 	{
-		GLuint vao;         // Handle for the vertex array object
-		GLuint vbos[2];     // Handles for the vertex buffer objects
-		GLuint nVertices;	// Number of vertices for the mesh
-		GLuint nIndices;    // Number of indices for the mesh
+		GLuint vao = 0;         // Handle for the vertex array object
+		GLuint vbos[2] = {};    // Handles for the vertex buffer objects
+		GLuint nVertices = 0;	// Number of vertices for the mesh
+		GLuint nIndices = 0;    // Number of indices for the mesh
 	};
 
 	// the available 3D shapes
@@ -49,6 +54,21 @@ private:
 	GLMesh m_TaperedCylinderMesh;
 	GLMesh m_TorusMesh;
 
+	// coarse patch meshes for the curved shapes, subdivided
+	// on the GPU by the tessellation shaders
+	GLMesh m_SpherePatchMesh;
+	GLMesh m_TorusPatchMesh;
+	GLMesh m_CylinderPatchMesh;
+	GLMesh m_TaperedCylinderPatchMesh;
+
+	// LOD chains for the curved shapes, from the finest
+	// level to the coarsest
+	std::vector<GLMesh> m_SphereLodMeshes;
+	std::vector<GLMesh> m_CylinderLodMeshes;
+	std::vector<int> m_CylinderLodSegments;
+	std::vector<LevelOfDetail::Level> m_SphereLodLevels;
+	std::vector<LevelOfDetail::Level> m_CylinderLodLevels;
+
 	bool m_bMemoryLayoutDone;
 
 public:
@@ -65,6 +85,30 @@ public:
 	void LoadTaperedCylinderMesh();
 	void LoadTorusMesh(float thickness = 0.2);
 
+	// methods for loading the patch meshes that are drawn
+	// with the tessellation shader program (OpenGL 4.1)
+	void LoadSpherePatchMesh();
+	void LoadTorusPatchMesh(float thickness = 0.2);
+	void LoadCylinderPatchMesh();
+	void LoadTaperedCylinderPatchMesh();
+
+	// methods for generating shape variants on the GPU with
+	// the mesh compute shader program (OpenGL 4.3), replacing
+	// the loaded mesh data in place
+	void GenerateTorusMesh(
+		GLuint computeProgram,
+		float thickness = 0.2);
+	void GenerateTaperedCylinderMesh(
+		GLuint computeProgram,
+		float topRadius = 0.5);
+
+	// methods for loading the LOD chains of the curved
+	// shapes and getting their levels for LOD selection
+	void LoadSphereLodMeshes();
+	void LoadCylinderLodMeshes();
+	const std::vector<LevelOfDetail::Level>& GetSphereLodLevels() const { return m_SphereLodLevels; }
+	const std::vector<LevelOfDetail::Level>& GetCylinderLodLevels() const { return m_CylinderLodLevels; }
+
 	// methods for drawing the shape mesh in the
 	// display window
 	void DrawBoxMesh();
@@ -87,6 +131,26 @@ public:
 	void DrawTorusMesh();
 	void DrawHalfTorusMesh();
 
+	// methods for drawing the patch meshes, the tessellation
+	// shader program must be active
+	void DrawSpherePatchMesh();
+	void DrawTorusPatchMesh();
+	void DrawCylinderPatchMesh(
+		bool bDrawTop = true,
+		bool bDrawBottom = true,
+		bool bDrawSides = true);
+	void DrawTaperedCylinderPatchMesh(
+		bool bDrawTop = true,
+		bool bDrawBottom = true,
+		bool bDrawSides = true);
+
+	// methods for drawing one level of the LOD chains
+	void DrawSphereLodMesh(int level);
+	void DrawCylinderLodMesh(
+		int level,
+		bool bDrawTop = true,
+		bool bDrawBottom = true,
+		bool bDrawSides = true);
 
 private:
 
@@ -98,4 +162,17 @@ private:
 	// called to set the memory layout 
 	// template for shader data
 	void SetShaderMemoryLayout();
+
+	// called to store patch corners in a VAO/VBO and
+	// set their memory layout for the tessellation shaders
+	void LoadPatchMesh(
+		GLMesh& mesh, const std::vector<GLfloat>& patches);
+
+	// called to store generated mesh data in a VAO/VBO
+	void LoadGeneratedMesh(
+		GLMesh& mesh, const RevolutionMeshes::MeshData& data);
+
+	// called to draw a range of patches from a patch mesh
+	void DrawPatches(
+		const GLMesh& mesh, GLint firstPatch, GLsizei patchCount);
 };
\ No newline at end of file
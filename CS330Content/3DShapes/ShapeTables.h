@@ -0,0 +1,391 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapetables.h
+// ============
+// compile-time generators for the fixed 3D primitive vertex tables:
+//     cone, cylinder, tapered cylinder, sphere
+//
+//  The tables are produced by constexpr functions parameterized by the
+//  segment count, so every level of detail that is used ends up in
+//  read-only data with no runtime generation cost.  The vertex layout
+//  matches ShapeMeshes: position (3), normal (3), texture coords (2).
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ShapeTables
+{
+	// number of interleaved floats for each vertex
+	constexpr std::size_t FloatsPerVertex = 8;
+
+	constexpr double Pi = 3.14159265358979323846;
+
+	/***********************************************************
+	 *  constexpr math helpers
+	 *
+	 *  The standard library versions are not constexpr, so the
+	 *  tables use these instead.  They are accurate to well
+	 *  below float precision over the ranges that are used.
+	 ***********************************************************/
+	constexpr double Abs(double x)
+	{
+		return (x < 0.0) ? -x : x;
+	}
+
+	constexpr double Sqrt(double x)
+	{
+		if (x <= 0.0)
+		{
+			return 0.0;
+		}
+
+		double guess = (x > 1.0) ? x : 1.0;
+		for (int i = 0; i < 64; i++)
+		{
+			double next = 0.5 * (guess + x / guess);
+			if (Abs(next - guess) <= 1e-15 * next)
+			{
+				return next;
+			}
+			guess = next;
+		}
+		return guess;
+	}
+
+	constexpr double Sin(double x)
+	{
+		// reduce the angle into [-pi, pi]
+		double turns = (x + Pi) / (2.0 * Pi);
+		long long whole = static_cast<long long>(turns);
+		if (turns < 0.0 && static_cast<double>(whole) != turns)
+		{
+			whole--;
+		}
+		x -= static_cast<double>(whole) * 2.0 * Pi;
+
+		// Taylor series, terms up to x^23
+		double term = x;
+		double sum = x;
+		for (int n = 1; n <= 11; n++)
+		{
+			term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+			sum += term;
+		}
+		return sum;
+	}
+
+	constexpr double Cos(double x)
+	{
+		return Sin(x + Pi / 2.0);
+	}
+
+	// write one interleaved vertex into a table
+	template<std::size_t N>
+	constexpr void PutVertex(
+		std::array<float, N>& table, std::size_t vertex,
+		double px, double py, double pz,
+		double nx, double ny, double nz,
+		double u, double v)
+	{
+		std::size_t i = vertex * FloatsPerVertex;
+		table[i + 0] = static_cast<float>(px);
+		table[i + 1] = static_cast<float>(py);
+		table[i + 2] = static_cast<float>(pz);
+		table[i + 3] = static_cast<float>(nx);
+		table[i + 4] = static_cast<float>(ny);
+		table[i + 5] = static_cast<float>(nz);
+		table[i + 6] = static_cast<float>(u);
+		table[i + 7] = static_cast<float>(v);
+	}
+
+	/***********************************************************
+	 *  FrustumLayout
+	 *
+	 *  Vertex ranges of a generated frustum (cone, cylinder or
+	 *  tapered cylinder).  The caps are triangle fans around the
+	 *  rim, the sides are a single triangle strip.
+	 ***********************************************************/
+	template<int Segments, bool HasTop>
+	struct FrustumLayout
+	{
+		static_assert(Segments >= 3, "a frustum needs at least 3 segments");
+
+		static constexpr int BottomStart = 0;
+		static constexpr int BottomCount = Segments;
+		static constexpr int TopStart = Segments;
+		static constexpr int TopCount = HasTop ? Segments : 0;
+		static constexpr int SideStart = TopStart + TopCount;
+		static constexpr int SideCount = 2 * (Segments + 1);
+		static constexpr int VertexCount = SideStart + SideCount;
+	};
+
+	/***********************************************************
+	 *  MakeFrustum()
+	 *
+	 *  Generate a frustum of height 1 standing on the XZ plane,
+	 *  with a bottom radius of 1 and the passed in top radius.
+	 *  A top radius of 0 produces a cone, 1 a cylinder.
+	 ***********************************************************/
+	template<int Segments, bool HasTop>
+	constexpr std::array<float, FrustumLayout<Segments, HasTop>::VertexCount * FloatsPerVertex>
+		MakeFrustum(double topRadius)
+	{
+		using Layout = FrustumLayout<Segments, HasTop>;
+		std::array<float, Layout::VertexCount * FloatsPerVertex> table{};
+
+		// the side slope is constant, so the analytic normal only
+		// depends on the angle around the Y axis
+		double slope = 1.0 - topRadius;
+		double normalScale = 1.0 / Sqrt(1.0 + slope * slope);
+
+		for (int i = 0; i < Segments; i++)
+		{
+			double angle = 2.0 * Pi * i / Segments;
+			double c = Cos(angle);
+			double s = -Sin(angle);
+
+			PutVertex(table, Layout::BottomStart + i,
+				c, 0.0, s,
+				0.0, -1.0, 0.0,
+				0.5 + 0.5 * s, 0.5 + 0.5 * c);
+			if (HasTop)
+			{
+				PutVertex(table, Layout::TopStart + i,
+					c * topRadius, 1.0, s * topRadius,
+					0.0, 1.0, 0.0,
+					0.5 + 0.5 * s, 0.5 + 0.5 * c);
+			}
+		}
+
+		// the strip repeats the first column so the texture seam closes
+		for (int i = 0; i <= Segments; i++)
+		{
+			double angle = 2.0 * Pi * i / Segments;
+			double c = Cos(angle);
+			double s = -Sin(angle);
+			double u = static_cast<double>(i) / Segments;
+
+			PutVertex(table, Layout::SideStart + 2 * i,
+				c * topRadius, 1.0, s * topRadius,
+				c * normalScale, slope * normalScale, s * normalScale,
+				u, 1.0);
+			PutVertex(table, Layout::SideStart + 2 * i + 1,
+				c, 0.0, s,
+				c * normalScale, slope * normalScale, s * normalScale,
+				u, 0.0);
+		}
+
+		return table;
+	}
+
+	/***********************************************************
+	 *  SphereLayout
+	 *
+	 *  Vertex and index counts of a generated UV sphere.  Rows
+	 *  run from the top pole to the bottom pole, and each row
+	 *  repeats its first vertex for the texture seam.  With an
+	 *  even number of stacks the first half of the indices
+	 *  covers exactly the upper hemisphere.
+	 ***********************************************************/
+	template<int Stacks, int Slices>
+	struct SphereLayout
+	{
+		static_assert(Stacks >= 2 && Slices >= 3, "a sphere needs at least 2 stacks and 3 slices");
+
+		static constexpr int RowLength = Slices + 1;
+		static constexpr int VertexCount = (Stacks + 1) * RowLength;
+		static constexpr int IndexCount = 6 * Slices * (Stacks - 1);
+	};
+
+	/***********************************************************
+	 *  MakeSphereVertices()
+	 *
+	 *  Generate the vertices of a unit sphere centered on the
+	 *  origin.  The normals are the positions themselves.
+	 ***********************************************************/
+	template<int Stacks, int Slices>
+	constexpr std::array<float, SphereLayout<Stacks, Slices>::VertexCount * FloatsPerVertex>
+		MakeSphereVertices()
+	{
+		using Layout = SphereLayout<Stacks, Slices>;
+		std::array<float, Layout::VertexCount * FloatsPerVertex> table{};
+
+		for (int stack = 0; stack <= Stacks; stack++)
+		{
+			double polar = Pi * stack / Stacks;
+			double y = Cos(polar);
+			double ring = Sin(polar);
+
+			for (int slice = 0; slice <= Slices; slice++)
+			{
+				// the seam sits at the back of the sphere (negative Z)
+				double azimuth = -Pi + 2.0 * Pi * slice / Slices;
+				double x = ring * Sin(azimuth);
+				double z = ring * Cos(azimuth);
+
+				PutVertex(table, stack * Layout::RowLength + slice,
+					x, y, z,
+					x, y, z,
+					static_cast<double>(slice) / Slices,
+					1.0 - static_cast<double>(stack) / Stacks);
+			}
+		}
+
+		return table;
+	}
+
+	/***********************************************************
+	 *  MakeSphereIndices()
+	 *
+	 *  Generate the triangle list indices for the sphere rows.
+	 *  The pole rows only get one triangle per slice.
+	 ***********************************************************/
+	template<int Stacks, int Slices>
+	constexpr std::array<std::uint32_t, SphereLayout<Stacks, Slices>::IndexCount>
+		MakeSphereIndices()
+	{
+		using Layout = SphereLayout<Stacks, Slices>;
+		std::array<std::uint32_t, Layout::IndexCount> indices{};
+
+		std::size_t n = 0;
+		for (int stack = 0; stack < Stacks; stack++)
+		{
+			std::uint32_t row = stack * Layout::RowLength;
+			std::uint32_t next = row + Layout::RowLength;
+
+			for (int slice = 0; slice < Slices; slice++)
+			{
+				if (stack != 0)
+				{
+					indices[n++] = row + slice;
+					indices[n++] = next + slice;
+					indices[n++] = row + slice + 1;
+				}
+				if (stack != Stacks - 1)
+				{
+					indices[n++] = row + slice + 1;
+					indices[n++] = next + slice;
+					indices[n++] = next + slice + 1;
+				}
+			}
+		}
+
+		return indices;
+	}
+
+	/***********************************************************
+	 *  VerifyFrustum()
+	 *
+	 *  Check a generated frustum against the analytic surface:
+	 *  unit normals, flat caps, and side normals that are
+	 *  perpendicular to the slant edge and point away from the
+	 *  Y axis.  Used in static_asserts.
+	 ***********************************************************/
+	template<int Segments, bool HasTop, std::size_t N>
+	constexpr bool VerifyFrustum(const std::array<float, N>& table, double tolerance = 1e-5)
+	{
+		using Layout = FrustumLayout<Segments, HasTop>;
+		static_assert(N == Layout::VertexCount * FloatsPerVertex, "table does not match the layout");
+
+		for (int v = 0; v < Layout::VertexCount; v++)
+		{
+			const float* p = &table[v * FloatsPerVertex];
+			double length = Sqrt(p[3] * p[3] + p[4] * p[4] + p[5] * p[5]);
+			if (Abs(length - 1.0) > tolerance)
+			{
+				return false;
+			}
+			if (v < Layout::SideStart)
+			{
+				double expected = (v < Layout::TopStart) ? -1.0 : 1.0;
+				if (Abs(p[4] - expected) > tolerance)
+				{
+					return false;
+				}
+			}
+		}
+
+		for (int i = 0; i <= Segments; i++)
+		{
+			const float* top = &table[(Layout::SideStart + 2 * i) * FloatsPerVertex];
+			const float* bottom = top + FloatsPerVertex;
+
+			// perpendicular to the slant edge
+			double ex = top[0] - bottom[0];
+			double ey = top[1] - bottom[1];
+			double ez = top[2] - bottom[2];
+			if (Abs(ex * bottom[3] + ey * bottom[4] + ez * bottom[5]) > tolerance)
+			{
+				return false;
+			}
+			// radial part parallel to the bottom rim position
+			if (Abs(bottom[0] * bottom[5] - bottom[2] * bottom[3]) > tolerance)
+			{
+				return false;
+			}
+			if (bottom[0] * bottom[3] + bottom[2] * bottom[5] <= 0.0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/***********************************************************
+	 *  VerifySphere()
+	 *
+	 *  Check a generated sphere: every vertex lies on the unit
+	 *  sphere, the normal equals the position, and all indices
+	 *  are in range.  Used in static_asserts.
+	 ***********************************************************/
+	template<int Stacks, int Slices, std::size_t N, std::size_t M>
+	constexpr bool VerifySphere(
+		const std::array<float, N>& table,
+		const std::array<std::uint32_t, M>& indices,
+		double tolerance = 1e-5)
+	{
+		using Layout = SphereLayout<Stacks, Slices>;
+		static_assert(N == Layout::VertexCount * FloatsPerVertex, "table does not match the layout");
+		static_assert(M == Layout::IndexCount, "indices do not match the layout");
+
+		for (int v = 0; v < Layout::VertexCount; v++)
+		{
+			const float* p = &table[v * FloatsPerVertex];
+			double length = Sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+			if (Abs(length - 1.0) > tolerance)
+			{
+				return false;
+			}
+			if (p[0] != p[3] || p[1] != p[4] || p[2] != p[5])
+			{
+				return false;
+			}
+		}
+
+		for (std::size_t i = 0; i < M; i++)
+		{
+			if (indices[i] >= static_cast<std::uint32_t>(Layout::VertexCount))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// the generated tables, one instance per level of detail that is used
+	template<int Segments>
+	constexpr auto Cone = MakeFrustum<Segments, false>(0.0);
+	template<int Segments>
+	constexpr auto Cylinder = MakeFrustum<Segments, true>(1.0);
+	template<int Segments>
+	constexpr auto TaperedCylinder = MakeFrustum<Segments, true>(0.5);
+	template<int Stacks, int Slices>
+	constexpr auto SphereVertices = MakeSphereVertices<Stacks, Slices>();
+	template<int Stacks, int Slices>
+	constexpr auto SphereIndices = MakeSphereIndices<Stacks, Slices>();
+}
@@ -1,5 +1,6 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <string>           // command line arguments
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -13,6 +14,8 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "RevolutionMeshes.h"
+#include "ComputeMeshes.h"
 
 // Namespace for declaring global variables
 namespace
@@ -29,6 +32,9 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+
+	// frames between the level of detail reports
+	const int LOD_REPORT_FRAMES = 120;
 }
 
 // Function declarations - all functions that are called manually
@@ -45,6 +51,13 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// run the mesh generation benchmark without opening a window
+	if ((argc > 1) && (std::string(argv[1]) == "--benchmark-meshes"))
+	{
+		RevolutionMeshes::RunBenchmark();
+		return(EXIT_SUCCESS);
+	}
+
 	// if GLFW fails initialization, then terminate the application
 	if (InitializeGLFW() == false)
 	{
@@ -66,16 +79,79 @@ int main(int argc, char* argv[])
 		return(EXIT_FAILURE);
 	}
 
+	// compare the compute shader mesh generators with the CPU
+	// generators and exit, this needs an OpenGL 4.3 context
+	if ((argc > 1) && (std::string(argv[1]) == "--validate-compute-meshes"))
+	{
+		bool bPassed = false;
+		if (GLEW_VERSION_4_3 &&
+			(0 != g_ShaderManager->LoadComputeShader("../../Utilities/shaders/meshComputeShader.glsl")))
+		{
+			bPassed = ComputeMeshes::Validate(g_ShaderManager->m_computeProgramID);
+		}
+		else
+		{
+			std::cout << "INFO: OpenGL 4.3 is required for compute shaders\n";
+		}
+		return(bPassed ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// rendering options from the command line
+	bool bTessellation = false;
+	bool bLevelOfDetail = false;
+	float lodQualityBias = 1.0f;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+		if (argument == "--tessellation")
+		{
+			bTessellation = true;
+		}
+		else if (argument == "--lod")
+		{
+			bLevelOfDetail = true;
+		}
+		else if ((argument == "--lod-bias") && (i + 1 < argc))
+		{
+			bLevelOfDetail = true;
+			lodQualityBias = (float)std::atof(argv[++i]);
+		}
+	}
+
 	// load the shader code from the external GLSL files
 	g_ShaderManager->LoadShaders(
 		"../../Utilities/shaders/vertexShader.glsl",
 		"../../Utilities/shaders/fragmentShader.glsl");
+
+	// the curved shapes can be tessellated on the GPU when the
+	// driver supports OpenGL 4.1 tessellation shaders
+	if (true == bTessellation)
+	{
+		if (GLEW_VERSION_4_1)
+		{
+			g_ShaderManager->LoadTessellationShaders(
+				"../../Utilities/shaders/tessVertexShader.glsl",
+				"../../Utilities/shaders/tessControlShader.glsl",
+				"../../Utilities/shaders/tessEvaluationShader.glsl",
+				"../../Utilities/shaders/fragmentShader.glsl");
+		}
+		else
+		{
+			std::cout << "INFO: OpenGL 4.1 is required for tessellation\n";
+		}
+	}
 	g_ShaderManager->use();
 
 	// try to create a new scene manager object and prepare the 3D scene
 	g_SceneManager = new SceneManager(g_ShaderManager);
+	if (true == bLevelOfDetail)
+	{
+		g_SceneManager->EnableLevelOfDetail(lodQualityBias);
+	}
 	g_SceneManager->PrepareScene();
 
+	int frameCount = 0;
+
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
 	while (!glfwWindowShouldClose(g_Window))
@@ -90,9 +166,25 @@ int main(int argc, char* argv[])
 		// convert from 3D object space to 2D view
 		g_ViewManager->PrepareSceneView();
 
+		// pass the camera to the level of detail selection
+		glm::vec3 cameraPosition;
+		float fieldOfView = 0.0f;
+		float viewportHeight = 0.0f;
+		g_ViewManager->GetViewParameters(cameraPosition, fieldOfView, viewportHeight);
+		g_SceneManager->SetLevelOfDetailView(cameraPosition, fieldOfView, viewportHeight);
+
 		// refresh the 3D scene
 		g_SceneManager->RenderScene();
 
+		// report the triangles saved by the level of detail selection
+		if ((true == bLevelOfDetail) && (0 == (++frameCount % LOD_REPORT_FRAMES)))
+		{
+			const LevelOfDetail::FrameStats& stats = g_SceneManager->GetLevelOfDetailStats();
+			std::cout << "LOD: " << stats.objects << " objects, "
+				<< stats.trianglesDrawn << " of " << stats.trianglesFull << " triangles drawn, "
+				<< stats.TrianglesSaved() << " saved per frame\n";
+		}
+
 
 		// Flips the the back buffer with the front buffer every frame.
 		glfwSwapBuffers(g_Window);
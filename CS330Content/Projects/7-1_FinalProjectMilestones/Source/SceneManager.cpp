@@ -35,6 +35,9 @@ SceneManager::SceneManager(ShaderManager *pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
 	m_basicMeshes = new ShapeMeshes();
+	m_modelMatrix = glm::mat4(1.0f);
+	m_bUseLevelOfDetail = false;
+	m_lodObject = 0;
 }
 
 /***********************************************************
@@ -271,6 +274,7 @@ void SceneManager::SetTransformations(
 	translation = glm::translate(positionXYZ);
 
 	modelView = translation * rotationX * rotationY * rotationZ * scale;
+	m_modelMatrix = modelView;
 
 	if (NULL != m_pShaderManager)
 	{
@@ -469,6 +473,161 @@ void SceneManager::SetupSceneLights()
 
 }
 
+/***********************************************************
+ *  DrawSphere()
+ *
+ *  This method is used for drawing a sphere with the current
+ *  shader settings.  When the tessellation shaders are loaded
+ *  the sphere is subdivided on the GPU to match its size on
+ *  the screen.
+ ***********************************************************/
+void SceneManager::DrawSphere()
+{
+	if (0 != m_pShaderManager->m_tessProgramID)
+	{
+		m_pShaderManager->useTessellation();
+		m_basicMeshes->DrawSpherePatchMesh();
+		m_pShaderManager->use();
+	}
+	else if (true == m_bUseLevelOfDetail)
+	{
+		LevelOfDetail::ObjectState& state = SelectObjectLevel(
+			m_basicMeshes->GetSphereLodLevels(), glm::vec3(0.0f), 1.0f);
+
+		SetLevelFade(state.fade, false);
+		m_basicMeshes->DrawSphereLodMesh(state.level);
+		if (state.previousLevel >= 0)
+		{
+			SetLevelFade(state.fade, true);
+			m_basicMeshes->DrawSphereLodMesh(state.previousLevel);
+		}
+		SetLevelFade(1.0f, false);
+	}
+	else
+	{
+		m_basicMeshes->DrawSphereMesh();
+	}
+}
+
+/***********************************************************
+ *  DrawCylinder()
+ *
+ *  This method is used for drawing a cylinder with the
+ *  current shader settings.  When the tessellation shaders
+ *  are loaded the cylinder is subdivided on the GPU to match
+ *  its size on the screen.
+ ***********************************************************/
+void SceneManager::DrawCylinder()
+{
+	if (0 != m_pShaderManager->m_tessProgramID)
+	{
+		m_pShaderManager->useTessellation();
+		m_basicMeshes->DrawCylinderPatchMesh();
+		m_pShaderManager->use();
+	}
+	else if (true == m_bUseLevelOfDetail)
+	{
+		// the bounding sphere of the unit cylinder
+		LevelOfDetail::ObjectState& state = SelectObjectLevel(
+			m_basicMeshes->GetCylinderLodLevels(), glm::vec3(0.0f, 0.5f, 0.0f), 1.118f);
+
+		SetLevelFade(state.fade, false);
+		m_basicMeshes->DrawCylinderLodMesh(state.level);
+		if (state.previousLevel >= 0)
+		{
+			SetLevelFade(state.fade, true);
+			m_basicMeshes->DrawCylinderLodMesh(state.previousLevel);
+		}
+		SetLevelFade(1.0f, false);
+	}
+	else
+	{
+		m_basicMeshes->DrawCylinderMesh();
+	}
+}
+
+/***********************************************************
+ *  SelectObjectLevel()
+ *
+ *  This method is used for choosing the LOD level of the
+ *  next curved object from its bounding sphere, transformed
+ *  by the current model matrix.
+ ***********************************************************/
+LevelOfDetail::ObjectState& SceneManager::SelectObjectLevel(
+	const std::vector<LevelOfDetail::Level>& levels,
+	const glm::vec3& center,
+	float radius)
+{
+	if (m_lodObject >= m_lodStates.size())
+	{
+		m_lodStates.resize(m_lodObject + 1);
+	}
+	LevelOfDetail::ObjectState& state = m_lodStates[m_lodObject++];
+
+	// the largest scale keeps the error estimate conservative
+	float worldScale = glm::max(glm::length(glm::vec3(m_modelMatrix[0])),
+		glm::max(glm::length(glm::vec3(m_modelMatrix[1])), glm::length(glm::vec3(m_modelMatrix[2]))));
+	glm::vec3 worldCenter = glm::vec3(m_modelMatrix * glm::vec4(center, 1.0f));
+
+	m_lodSelector.Select(state, levels, worldCenter, radius * worldScale, worldScale);
+	return(state);
+}
+
+/***********************************************************
+ *  SetLevelFade()
+ *
+ *  This method is used for setting the dither fade of the
+ *  level being drawn, the level fading out is drawn into
+ *  the pixels that the new level leaves out.
+ ***********************************************************/
+void SceneManager::SetLevelFade(
+	float fade,
+	bool bFadingOut)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setFloatValue("lodFade", fade);
+		m_pShaderManager->setBoolValue("bLodFadeComplement", bFadingOut);
+	}
+}
+
+/***********************************************************
+ *  EnableLevelOfDetail()
+ *
+ *  This method is used for drawing the curved shapes from
+ *  their LOD chains, it must be called before PrepareScene().
+ ***********************************************************/
+void SceneManager::EnableLevelOfDetail(float qualityBias)
+{
+	m_bUseLevelOfDetail = true;
+	m_lodSelector.SetQualityBias(qualityBias);
+}
+
+/***********************************************************
+ *  SetLevelOfDetailView()
+ *
+ *  This method is used for passing the camera of the next
+ *  frame to the LOD selection.
+ ***********************************************************/
+void SceneManager::SetLevelOfDetailView(
+	const glm::vec3& cameraPosition,
+	float fieldOfViewDegrees,
+	float viewportHeight)
+{
+	m_lodSelector.SetView(cameraPosition, fieldOfViewDegrees, viewportHeight);
+}
+
+/***********************************************************
+ *  GetLevelOfDetailStats()
+ *
+ *  This method is used for getting the triangles drawn and
+ *  saved by the LOD selection in the last rendered frame.
+ ***********************************************************/
+const LevelOfDetail::FrameStats& SceneManager::GetLevelOfDetailStats() const
+{
+	return(m_lodSelector.GetFrameStats());
+}
+
 /***********************************************************
  *  PrepareScene()
  *
@@ -492,6 +651,19 @@ void SceneManager::PrepareScene()
 	m_basicMeshes->LoadPrismMesh();
 	m_basicMeshes->LoadTaperedCylinderMesh();
 
+	// the patch meshes are only drawn when the GPU supports
+	// the tessellation shaders
+	if (0 != m_pShaderManager->m_tessProgramID)
+	{
+		m_basicMeshes->LoadSpherePatchMesh();
+		m_basicMeshes->LoadCylinderPatchMesh();
+	}
+	else if (true == m_bUseLevelOfDetail)
+	{
+		m_basicMeshes->LoadSphereLodMeshes();
+		m_basicMeshes->LoadCylinderLodMeshes();
+	}
+
 }
 
 /***********************************************************
@@ -502,6 +674,11 @@ void SceneManager::PrepareScene()
  ***********************************************************/
 void SceneManager::RenderScene()
 {
+	// the curved objects are numbered in drawing order for
+	// their LOD selection
+	m_lodSelector.BeginFrame();
+	m_lodObject = 0;
+
 	// declare the variables for the transformations
 	glm::vec3 scaleXYZ;
 	float XrotationDegrees = 0.0f;
@@ -574,7 +751,7 @@ void SceneManager::RenderScene()
 		glm::vec3(0.0, 0.0, -3.0)); // position
 	SetShaderColor(0.2, 0.2, 0.2, 1); // grey
 
-	m_basicMeshes->DrawCylinderMesh();
+	DrawCylinder();
 
 	// left leg for monitor base
 	SetTransformations(
@@ -598,7 +775,7 @@ void SceneManager::RenderScene()
 		0.0, 0.0, 0.0, // rotation
 		glm::vec3(0.0, 0.0, -3.0)); // position
 	SetShaderColor(0.2, 0.2, 0.2, 1); // grey
-	m_basicMeshes->DrawCylinderMesh();
+	DrawCylinder();
 
 	// connector piece that attatches to support cylinder and monitor screen
 	SetTransformations(
@@ -763,7 +940,7 @@ void SceneManager::RenderScene()
 		glm::vec3(2.3, 0.18, 2.0)); // position
 	SetShaderColor(0.2, 0.2, 0.2, 1.0); // dark gray
 
-	m_basicMeshes->DrawSphereMesh();
+	DrawSphere();
 
 	// mouse scroll wheel made with cylinder
 	SetTransformations(
@@ -772,7 +949,7 @@ void SceneManager::RenderScene()
 		glm::vec3(2.35, 0.25, 1.5)); // position
 	SetShaderColor(0.0, 0.0, 0.0, 1.0); // black
 
-	m_basicMeshes->DrawCylinderMesh();
+	DrawCylinder();
 
 	// mouse side button closest to scroll wheel
 	SetTransformations(
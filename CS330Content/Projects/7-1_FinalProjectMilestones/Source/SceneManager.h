@@ -11,6 +11,7 @@
 
 #include "ShaderManager.h"
 #include "ShapeMeshes.h"
+#include "LevelOfDetail.h"
 
 #include <string>
 #include <vector>
@@ -56,6 +57,15 @@ private:
 	TEXTURE_INFO m_textureIDs[16];
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// model matrix of the object being drawn
+	glm::mat4 m_modelMatrix;
+
+	// level of detail selection for the curved shapes, the
+	// objects are identified by their order in RenderScene()
+	bool m_bUseLevelOfDetail;
+	LevelOfDetail::Selector m_lodSelector;
+	std::vector<LevelOfDetail::ObjectState> m_lodStates;
+	std::size_t m_lodObject;
 
 	// load texture images and convert to OpenGL texture data
 	bool CreateGLTexture(const char* filename, std::string tag);
@@ -97,6 +107,23 @@ private:
 	void SetShaderMaterial(
 		std::string materialTag);
 
+	// draw the curved shapes, tessellated on the GPU when
+	// the tessellation shaders are loaded
+	void DrawSphere();
+	void DrawCylinder();
+
+	// choose the level of detail of the next object from its
+	// bounding sphere in object space
+	LevelOfDetail::ObjectState& SelectObjectLevel(
+		const std::vector<LevelOfDetail::Level>& levels,
+		const glm::vec3& center,
+		float radius);
+
+	// set the dither fade of the level being drawn into the shader
+	void SetLevelFade(
+		float fade,
+		bool bFadingOut);
+
 public:
 
 	// The following methods are for the students to 
@@ -112,4 +139,15 @@ public:
 	// pre-define the object materials for lighting
 	void DefineObjectMaterials();
 
+	// draw the curved shapes from their LOD chains, a quality
+	// bias above 1 allows more error for more throughput
+	void EnableLevelOfDetail(float qualityBias = 1.0f);
+	// set the camera used for the LOD selection of the next frame
+	void SetLevelOfDetailView(
+		const glm::vec3& cameraPosition,
+		float fieldOfViewDegrees,
+		float viewportHeight);
+	// triangle counts of the last rendered frame
+	const LevelOfDetail::FrameStats& GetLevelOfDetailStats() const;
+
 };
\ No newline at end of file
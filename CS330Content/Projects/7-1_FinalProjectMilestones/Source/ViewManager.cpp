@@ -300,5 +300,23 @@ void ViewManager::PrepareSceneView()
 		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
 		// set the view position of the camera into the shader for proper rendering
 		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		// set the viewport size for the screen-space tessellation levels
+		m_pShaderManager->setVec2Value("viewportSize", (float)WINDOW_WIDTH, (float)WINDOW_HEIGHT);
 	}
-}
\ No newline at end of file
+}
+
+/***********************************************************
+ *  GetViewParameters()
+ *
+ *  This method is used for getting the values that decide
+ *  how large the 3D objects appear in the viewport.
+ ***********************************************************/
+void ViewManager::GetViewParameters(
+	glm::vec3& cameraPosition,
+	float& fieldOfViewDegrees,
+	float& viewportHeight) const
+{
+	cameraPosition = g_pCamera->Position;
+	fieldOfViewDegrees = g_pCamera->Zoom;
+	viewportHeight = (float)WINDOW_HEIGHT;
+}
@@ -44,4 +44,11 @@ public:
 	
 	// prepare the conversion from 3D object display to 2D scene display
 	void PrepareSceneView();
+
+	// get the camera position, vertical field of view in degrees,
+	// and viewport height used for level of detail selection
+	void GetViewParameters(
+		glm::vec3& cameraPosition,
+		float& fieldOfViewDegrees,
+		float& viewportHeight) const;
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// circlebenchmark.cpp
+// ============
+// compare the polygon and SDF circle drawing modes of the instanced
+// renderer over several circle radius distributions
+//
+//  The GPU time of the draw calls is measured with timer queries, so
+//  the instance upload, which is the same for both modes, is left out.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CircleBenchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	const int g_WarmupFrames = 3;
+	const int g_MeasuredFrames = 20;
+
+	// circles drawn from one radius distribution, the radius is
+	// log-uniform between the two bounds (in NDC units)
+	struct Distribution
+	{
+		const char* name;
+		int circles;
+		float minRadius;
+		float maxRadius;
+	};
+
+	const Distribution g_Distributions[] = {
+		{ "tiny (0.5 px)",     200000, 0.002f, 0.002f },
+		{ "small (2-5 px)",    200000, 0.008f, 0.02f },
+		{ "medium (12 px)",     50000, 0.05f, 0.05f },
+		{ "large (50 px)",       5000, 0.2f, 0.2f },
+		{ "mixed (0.5-50 px)", 100000, 0.002f, 0.2f },
+	};
+
+	// small deterministic generator so every run draws the same circles
+	float NextUnit(unsigned int& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return (state >> 8) * (1.0f / 16777216.0f);
+	}
+
+	std::vector<InstancedRenderer::Instance> MakeCircles(const Distribution& distribution)
+	{
+		std::vector<InstancedRenderer::Instance> circles(distribution.circles);
+		unsigned int state = 12345u;
+		float logMin = std::log(distribution.minRadius);
+		float logMax = std::log(distribution.maxRadius);
+		for (InstancedRenderer::Instance& circle : circles)
+		{
+			circle.x = NextUnit(state) * 2.0f - 1.0f;
+			circle.y = NextUnit(state) * 2.0f - 1.0f;
+			circle.size = std::exp(logMin + (logMax - logMin) * NextUnit(state));
+			circle.red = NextUnit(state);
+			circle.green = NextUnit(state);
+			circle.blue = NextUnit(state);
+		}
+		return circles;
+	}
+
+	// average GPU milliseconds to draw the circles in one mode
+	double MeasureMode(
+		InstancedRenderer& renderer,
+		const std::vector<InstancedRenderer::Instance>& circles,
+		InstancedRenderer::CIRCLE_MODE mode)
+	{
+		renderer.SetCircleMode(mode);
+		renderer.MapInstances(InstancedRenderer::SQUARE, 0);
+
+		GLuint query = 0;
+		glGenQueries(1, &query);
+
+		double totalNanoseconds = 0.0;
+		for (int frame = 0; frame < g_WarmupFrames + g_MeasuredFrames; frame++)
+		{
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			InstancedRenderer::Instance* instances = renderer.MapInstances(InstancedRenderer::CIRCLE, circles.size());
+			std::memcpy(instances, circles.data(), sizeof(InstancedRenderer::Instance) * circles.size());
+			renderer.UnmapInstances(InstancedRenderer::CIRCLE);
+
+			glBeginQuery(GL_TIME_ELAPSED, query);
+			renderer.Draw();
+			glEndQuery(GL_TIME_ELAPSED);
+
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+			if (frame >= g_WarmupFrames)
+			{
+				totalNanoseconds += (double)nanoseconds;
+			}
+		}
+
+		glDeleteQueries(1, &query);
+		return totalNanoseconds / g_MeasuredFrames / 1.0e6;
+	}
+}
+
+/***********************************************************
+ *  RunCircleBenchmark()
+ *
+ *  This function is used for timing both circle modes on
+ *  the same circles.  The polygon mode costs a fixed number
+ *  of vertices per circle, the SDF mode four vertices and
+ *  slightly more pixels per circle.
+ ***********************************************************/
+void RunCircleBenchmark(
+	InstancedRenderer& renderer,
+	int width,
+	int height)
+{
+	InstancedRenderer::CIRCLE_MODE previousMode = renderer.GetCircleMode();
+
+	glViewport(0, 0, width, height);
+	renderer.SetViewportSize(width, height);
+
+	printf("Circle drawing benchmark, %dx%d, GPU ms per frame:\n", width, height);
+	printf("  %-18s %8s %10s %10s %8s\n", "radius", "circles", "polygon", "sdf quad", "speedup");
+	for (const Distribution& distribution : g_Distributions)
+	{
+		std::vector<InstancedRenderer::Instance> circles = MakeCircles(distribution);
+		double polygonMs = MeasureMode(renderer, circles, InstancedRenderer::POLYGON_CIRCLES);
+		double sdfMs = MeasureMode(renderer, circles, InstancedRenderer::SDF_CIRCLES);
+
+		printf("  %-18s %8d %10.3f %10.3f %7.2fx\n",
+			distribution.name, distribution.circles, polygonMs, sdfMs,
+			(sdfMs > 0.0) ? polygonMs / sdfMs : 0.0);
+	}
+
+	renderer.SetCircleMode(previousMode);
+}
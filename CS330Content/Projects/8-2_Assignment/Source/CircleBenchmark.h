@@ -0,0 +1,17 @@
+///////////////////////////////////////////////////////////////////////////////
+// circlebenchmark.h
+// ============
+// compare the polygon and SDF circle drawing modes of the instanced
+// renderer over several circle radius distributions
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "InstancedRenderer.h"
+
+// draw every distribution in both circle modes and print the GPU
+// time per frame, the current GL context must stay current
+void RunCircleBenchmark(
+	InstancedRenderer& renderer,
+	int width,
+	int height);
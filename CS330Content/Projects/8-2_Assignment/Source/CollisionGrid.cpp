@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////
+// collisiongrid.cpp
+// ============
+// uniform grid broad phase for the circles and bricks of the simulation
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CollisionGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// the most cells along one axis, a limit for very small objects
+	const int g_MaxCellsPerAxis = 1024;
+}
+
+/***********************************************************
+ *  CollisionGrid()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CollisionGrid::CollisionGrid(float minX, float minY, float maxX, float maxY)
+{
+	m_minX = minX;
+	m_minY = minY;
+	m_maxX = maxX;
+	m_maxY = maxY;
+	m_cellSize = 0.0f;
+	m_inverseCellSize = 0.0f;
+	m_columns = 0;
+	m_rows = 0;
+
+	SetCellSize((maxX - minX) / 16.0f);
+}
+
+/***********************************************************
+ *  SetCellSize()
+ *
+ *  This method is used for choosing the side of the grid
+ *  cells.  The number of cells is limited, so very small
+ *  sizes are rounded up.
+ ***********************************************************/
+void CollisionGrid::SetCellSize(float cellSize)
+{
+	float width = m_maxX - m_minX;
+	float height = m_maxY - m_minY;
+	float smallest = std::max(width, height) / g_MaxCellsPerAxis;
+	if (!(cellSize > smallest))
+	{
+		cellSize = smallest;
+	}
+	if (cellSize == m_cellSize)
+	{
+		return;
+	}
+
+	m_cellSize = cellSize;
+	m_inverseCellSize = 1.0f / cellSize;
+	m_columns = std::max(1, static_cast<int>(std::ceil(width * m_inverseCellSize)));
+	m_rows = std::max(1, static_cast<int>(std::ceil(height * m_inverseCellSize)));
+
+	std::size_t cells = static_cast<std::size_t>(m_columns) * m_rows;
+	m_cellStart.assign(cells + 1, 0);
+	m_cellCursor.assign(cells, 0);
+	m_entries.clear();
+}
+
+/***********************************************************
+ *  Column()
+ *
+ *  This method is used for finding the grid column of an
+ *  x coordinate, clamped to the grid.
+ ***********************************************************/
+int CollisionGrid::Column(float x) const
+{
+	int column = static_cast<int>(std::floor((x - m_minX) * m_inverseCellSize));
+	return(std::min(std::max(column, 0), m_columns - 1));
+}
+
+/***********************************************************
+ *  Row()
+ *
+ *  This method is used for finding the grid row of a y
+ *  coordinate, clamped to the grid.
+ ***********************************************************/
+int CollisionGrid::Row(float y) const
+{
+	int row = static_cast<int>(std::floor((y - m_minY) * m_inverseCellSize));
+	return(std::min(std::max(row, 0), m_rows - 1));
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used for bucketing the objects into the
+ *  cells with a counting sort: the entries of every cell
+ *  are counted, the counts are turned into the start of
+ *  every cell, and the entries are scattered into place.
+ *  Within a cell the entries keep the order of the input.
+ ***********************************************************/
+void CollisionGrid::Build(
+	const float* x,
+	const float* y,
+	const float* extent,
+	const std::uint32_t* ids,
+	std::size_t count)
+{
+	std::size_t cells = GetCellCount();
+	std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+
+	// count the entries of every cell, shifted by one
+	for (std::size_t i = 0; i < count; i++)
+	{
+		int column0 = Column(x[i] - extent[i]);
+		int column1 = Column(x[i] + extent[i]);
+		int row0 = Row(y[i] - extent[i]);
+		int row1 = Row(y[i] + extent[i]);
+		for (int row = row0; row <= row1; row++)
+		{
+			std::uint32_t* rowStart = &m_cellStart[static_cast<std::size_t>(row) * m_columns + 1];
+			for (int column = column0; column <= column1; column++)
+			{
+				rowStart[column]++;
+			}
+		}
+	}
+
+	// the running sum gives the first entry of every cell
+	for (std::size_t c = 0; c < cells; c++)
+	{
+		m_cellStart[c + 1] += m_cellStart[c];
+	}
+	std::copy(m_cellStart.begin(), m_cellStart.end() - 1, m_cellCursor.begin());
+	m_entries.resize(m_cellStart[cells]);
+
+	// scatter the entries into their cells
+	for (std::size_t i = 0; i < count; i++)
+	{
+		Entry entry;
+		entry.x = x[i];
+		entry.y = y[i];
+		entry.extent = extent[i];
+		entry.id = (NULL != ids) ? ids[i] : static_cast<std::uint32_t>(i);
+
+		int column0 = Column(x[i] - extent[i]);
+		int column1 = Column(x[i] + extent[i]);
+		int row0 = Row(y[i] - extent[i]);
+		int row1 = Row(y[i] + extent[i]);
+		for (int row = row0; row <= row1; row++)
+		{
+			std::uint32_t* rowCursor = &m_cellCursor[static_cast<std::size_t>(row) * m_columns];
+			for (int column = column0; column <= column1; column++)
+			{
+				m_entries[rowCursor[column]++] = entry;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  Query()
+ *
+ *  This method is used for getting the entries of the cell
+ *  that contains a point.  Every object whose bounding
+ *  square contains the point is among them, once.
+ ***********************************************************/
+const CollisionGrid::Entry* CollisionGrid::Query(float x, float y, std::size_t& count) const
+{
+	std::size_t cell = static_cast<std::size_t>(Row(y)) * m_columns + Column(x);
+	count = m_cellStart[cell + 1] - m_cellStart[cell];
+	return(m_entries.data() + m_cellStart[cell]);
+}
+
+/***********************************************************
+ *  FindPairs()
+ *
+ *  This method is used for finding the objects with
+ *  overlapping bounding squares in a range of cells.  Two
+ *  objects that span several cells meet in all of them, so
+ *  a pair is only kept in the cell that holds the lower
+ *  left corner of the overlap of the two squares.
+ ***********************************************************/
+std::size_t CollisionGrid::FindPairs(
+	std::size_t firstCell,
+	std::size_t endCell,
+	std::vector<Pair>& pairs) const
+{
+	std::size_t tests = 0;
+	endCell = std::min(endCell, GetCellCount());
+	for (std::size_t cell = firstCell; cell < endCell; cell++)
+	{
+		const Entry* begin = m_entries.data() + m_cellStart[cell];
+		const Entry* end = m_entries.data() + m_cellStart[cell + 1];
+		for (const Entry* a = begin; a < end; a++)
+		{
+			for (const Entry* b = a + 1; b < end; b++)
+			{
+				tests++;
+				float reach = a->extent + b->extent;
+				if (std::fabs(a->x - b->x) >= reach || std::fabs(a->y - b->y) >= reach)
+				{
+					continue;
+				}
+
+				// skip the pair if it was already reported in an earlier cell
+				float cornerX = std::max(a->x - a->extent, b->x - b->extent);
+				float cornerY = std::max(a->y - a->extent, b->y - b->extent);
+				std::size_t owner = static_cast<std::size_t>(Row(cornerY)) * m_columns + Column(cornerX);
+				if (owner != cell)
+				{
+					continue;
+				}
+
+				Pair pair;
+				pair.first = std::min(a->id, b->id);
+				pair.second = std::max(a->id, b->id);
+				pairs.push_back(pair);
+			}
+		}
+	}
+	return(tests);
+}
+
+/***********************************************************
+ *  FindPairs()
+ *
+ *  This method is used for finding the objects with
+ *  overlapping bounding squares in the whole grid.
+ ***********************************************************/
+std::size_t CollisionGrid::FindPairs(std::vector<Pair>& pairs) const
+{
+	return(FindPairs(0, GetCellCount(), pairs));
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// collisiongrid.h
+// ============
+// uniform grid broad phase for the circles and bricks of the simulation
+//
+//  The grid is rebuilt from scratch every step.  Each object is added
+//  to every cell its bounding square overlaps, and the entries are
+//  bucketed by cell with a counting sort into one flat array, so a
+//  cell is a contiguous run of entries and no per-cell containers are
+//  allocated.  Objects only meet the objects of the cells they share,
+//  which keeps the broad phase near O(n) as the population grows.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/***********************************************************
+ *  CollisionGrid
+ *
+ *  This class contains the code for bucketing objects,
+ *  given as a center and half extent, into the cells of a
+ *  uniform grid over a rectangular region.
+ ***********************************************************/
+class CollisionGrid
+{
+public:
+	// one object in one cell, stored in cell order
+	struct Entry
+	{
+		float x, y;
+		float extent;		// half the side of the bounding square
+		std::uint32_t id;
+	};
+
+	// two objects whose bounding squares overlap, first < second
+	struct Pair
+	{
+		std::uint32_t first;
+		std::uint32_t second;
+	};
+
+	// constructor, objects outside the region are kept in the
+	// border cells
+	CollisionGrid(float minX, float minY, float maxX, float maxY);
+
+	// set the side of the square cells, best at about the size of
+	// the typical object
+	void SetCellSize(float cellSize);
+	float GetCellSize() const { return m_cellSize; }
+	std::size_t GetCellCount() const { return m_cellStart.size() - 1; }
+
+	// bucket count objects into the cells, the id of object i is
+	// ids[i], or i when ids is NULL
+	void Build(
+		const float* x,
+		const float* y,
+		const float* extent,
+		const std::uint32_t* ids,
+		std::size_t count);
+
+	// the entries of the cell containing a point
+	const Entry* Query(float x, float y, std::size_t& count) const;
+
+	// append the overlapping pairs found in cells [firstCell, endCell),
+	// every pair is reported once, in the first cell the two objects
+	// share, and the number of pair tests made is returned
+	std::size_t FindPairs(
+		std::size_t firstCell,
+		std::size_t endCell,
+		std::vector<Pair>& pairs) const;
+	std::size_t FindPairs(std::vector<Pair>& pairs) const;
+
+	// the entries in cell order, for inspection and statistics
+	const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+private:
+	float m_minX, m_minY;
+	float m_maxX, m_maxY;
+	float m_cellSize;
+	float m_inverseCellSize;
+	int m_columns;
+	int m_rows;
+
+	// cell c holds m_entries[m_cellStart[c]] up to m_cellStart[c + 1]
+	std::vector<std::uint32_t> m_cellStart;
+	std::vector<std::uint32_t> m_cellCursor;
+	std::vector<Entry> m_entries;
+
+	// the column or row of a coordinate, clamped to the grid
+	int Column(float x) const;
+	int Row(float y) const;
+};
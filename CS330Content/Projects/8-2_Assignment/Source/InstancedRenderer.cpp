@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedrenderer.cpp
+// ============
+// draw the circles and bricks of the simulation with one instanced
+// draw call per shape type
+///////////////////////////////////////////////////////////////////////////////
+
+#include "InstancedRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	// segments of the unit circle mesh
+	const int g_CircleSegments = 32;
+	// smallest instance buffer, in instances
+	const std::size_t g_MinimumCapacity = 1024;
+}
+
+/***********************************************************
+ *  InstancedRenderer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+InstancedRenderer::InstancedRenderer()
+{
+	m_shaderManager.m_programID = 0;
+	m_sdfShaderManager.m_programID = 0;
+	m_sdfVao = 0;
+	m_sdfMeshBuffer = 0;
+	m_circleMode = POLYGON_CIRCLES;
+}
+
+/***********************************************************
+ *  ~InstancedRenderer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+InstancedRenderer::~InstancedRenderer()
+{
+	for (ShapeBatch& batch : m_batches)
+	{
+		glDeleteBuffers(1, &batch.meshBuffer);
+		glDeleteBuffers(1, &batch.instanceBuffer);
+		glDeleteVertexArrays(1, &batch.vao);
+	}
+	glDeleteBuffers(1, &m_sdfMeshBuffer);
+	glDeleteVertexArrays(1, &m_sdfVao);
+	if (0 != m_shaderManager.m_programID)
+	{
+		glDeleteProgram(m_shaderManager.m_programID);
+	}
+	if (0 != m_sdfShaderManager.m_programID)
+	{
+		glDeleteProgram(m_sdfShaderManager.m_programID);
+	}
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the unit circle and
+ *  unit square meshes and loading the instancing shaders.
+ ***********************************************************/
+bool InstancedRenderer::Initialize(
+	const char* vertexShaderPath,
+	const char* fragmentShaderPath,
+	const char* sdfVertexShaderPath,
+	const char* sdfFragmentShaderPath)
+{
+	if ((0 == m_shaderManager.LoadShaders(vertexShaderPath, fragmentShaderPath)) ||
+		(0 == m_sdfShaderManager.LoadShaders(sdfVertexShaderPath, sdfFragmentShaderPath)))
+	{
+		return(false);
+	}
+
+	// the circle is drawn as a convex polygon like GL_POLYGON
+	std::vector<float> circle;
+	for (int i = 0; i < g_CircleSegments; i++)
+	{
+		double angle = 2.0 * 3.14159265358979 * i / g_CircleSegments;
+		circle.push_back((float)std::cos(angle));
+		circle.push_back((float)std::sin(angle));
+	}
+	CreateBatch(m_batches[CIRCLE], circle.data(), g_CircleSegments, GL_TRIANGLE_FAN);
+
+	const float square[] = {
+		0.5f, 0.5f,
+		0.5f, -0.5f,
+		-0.5f, -0.5f,
+		-0.5f, 0.5f };
+	CreateBatch(m_batches[SQUARE], square, 4, GL_TRIANGLE_FAN);
+
+	// the SDF quad reads its instances from the circle buffer
+	const float quad[] = {
+		-1.0f, -1.0f,
+		1.0f, -1.0f,
+		-1.0f, 1.0f,
+		1.0f, 1.0f };
+	glGenVertexArrays(1, &m_sdfVao);
+	glBindVertexArray(m_sdfVao);
+
+	glGenBuffers(1, &m_sdfMeshBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, m_sdfMeshBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, (void*)0);
+	glEnableVertexAttribArray(0);
+
+	SetInstanceAttributes(m_batches[CIRCLE].instanceBuffer);
+	glBindVertexArray(0);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetViewportSize()
+ *
+ *  This method is used for passing the framebuffer size to
+ *  the SDF shader, which pads each quad by one pixel.
+ ***********************************************************/
+void InstancedRenderer::SetViewportSize(int width, int height)
+{
+	m_sdfShaderManager.use();
+	m_sdfShaderManager.setVec2Value("viewportSize", (float)width, (float)height);
+}
+
+/***********************************************************
+ *  CreateBatch()
+ *
+ *  This method is used for creating the VAO of one shape
+ *  type: the mesh advances per vertex and the instance
+ *  attributes advance once per instance.
+ ***********************************************************/
+void InstancedRenderer::CreateBatch(
+	ShapeBatch& batch,
+	const float* meshVertices,
+	GLsizei meshVertexCount,
+	GLenum primitive)
+{
+	batch.primitive = primitive;
+	batch.meshVertices = meshVertexCount;
+
+	glGenVertexArrays(1, &batch.vao);
+	glBindVertexArray(batch.vao);
+
+	glGenBuffers(1, &batch.meshBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, batch.meshBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 2 * meshVertexCount, meshVertices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, (void*)0);
+	glEnableVertexAttribArray(0);
+
+	glGenBuffers(1, &batch.instanceBuffer);
+	SetInstanceAttributes(batch.instanceBuffer);
+
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  SetInstanceAttributes()
+ *
+ *  This method is used for pointing the instance attributes
+ *  of the bound VAO at an instance buffer.  The buffer name
+ *  stays the same when it is orphaned, so this is only done
+ *  once.
+ ***********************************************************/
+void InstancedRenderer::SetInstanceAttributes(GLuint instanceBuffer)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, x));
+	glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, size));
+	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, red));
+	for (GLuint attribute = 1; attribute <= 3; attribute++)
+	{
+		glVertexAttribDivisor(attribute, 1);
+		glEnableVertexAttribArray(attribute);
+	}
+}
+
+/***********************************************************
+ *  MapInstances()
+ *
+ *  This method is used for getting write only memory for
+ *  this frame's instances.  The buffer is orphaned on every
+ *  map, so the driver never waits for the previous frame
+ *  to finish drawing from it.
+ ***********************************************************/
+InstancedRenderer::Instance* InstancedRenderer::MapInstances(SHAPE shape, std::size_t count)
+{
+	ShapeBatch& batch = m_batches[shape];
+	batch.count = count;
+	if (0 == count)
+	{
+		return(NULL);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, batch.instanceBuffer);
+	if (count > batch.capacity)
+	{
+		batch.capacity = std::max(g_MinimumCapacity, std::max(count, batch.capacity * 2));
+	}
+	glBufferData(GL_ARRAY_BUFFER, sizeof(Instance) * batch.capacity, NULL, GL_STREAM_DRAW);
+
+	void* memory = glMapBufferRange(GL_ARRAY_BUFFER, 0, sizeof(Instance) * count,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	return(static_cast<Instance*>(memory));
+}
+
+/***********************************************************
+ *  UnmapInstances()
+ *
+ *  This method is used for handing the written instances
+ *  back to OpenGL before drawing.
+ ***********************************************************/
+void InstancedRenderer::UnmapInstances(SHAPE shape)
+{
+	ShapeBatch& batch = m_batches[shape];
+	if (0 == batch.count)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, batch.instanceBuffer);
+	if (GL_FALSE == glUnmapBuffer(GL_ARRAY_BUFFER))
+	{
+		// the buffer contents were lost, skip this frame
+		batch.count = 0;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  Draw()
+ *
+ *  This method is used for drawing the mapped instances with
+ *  one draw call per shape type.  The circles are drawn
+ *  first so the bricks stay on top, as before.
+ ***********************************************************/
+void InstancedRenderer::Draw()
+{
+	for (int shape = 0; shape < SHAPE_COUNT; shape++)
+	{
+		const ShapeBatch& batch = m_batches[shape];
+		if (0 == batch.count)
+		{
+			continue;
+		}
+
+		if ((CIRCLE == shape) && (SDF_CIRCLES == m_circleMode))
+		{
+			// four vertices per circle, the edge coverage is blended
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			m_sdfShaderManager.use();
+			glBindVertexArray(m_sdfVao);
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)batch.count);
+			glDisable(GL_BLEND);
+		}
+		else
+		{
+			m_shaderManager.use();
+			glBindVertexArray(batch.vao);
+			glDrawArraysInstanced(batch.primitive, 0, batch.meshVertices, (GLsizei)batch.count);
+		}
+	}
+
+	glBindVertexArray(0);
+}
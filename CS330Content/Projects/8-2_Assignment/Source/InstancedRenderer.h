@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedrenderer.h
+// ============
+// draw the circles and bricks of the simulation with one instanced
+// draw call per shape type
+//
+//  Each shape type has one mesh in unit size.  The position, size and
+//  color of every instance are written straight into a mapped buffer
+//  each frame, so the CPU cost is one store per instance instead of
+//  hundreds of immediate mode vertices.  Circles can also be drawn as
+//  one quad each, shaded with a signed distance function.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include "ShaderManager.h"
+
+#include <cstddef>
+
+/***********************************************************
+ *  InstancedRenderer
+ *
+ *  This class contains the code for streaming the instance
+ *  data of the simulation and drawing it in a core profile
+ *  OpenGL 3.3 context.
+ ***********************************************************/
+class InstancedRenderer
+{
+public:
+	// the shape types, each drawn with one instanced draw call
+	enum SHAPE { CIRCLE, SQUARE, SHAPE_COUNT };
+
+	// how circles are drawn: as polygons, or as quads with an
+	// anti-aliased disc evaluated in the fragment shader
+	enum CIRCLE_MODE { POLYGON_CIRCLES, SDF_CIRCLES };
+
+	// per instance data, the size is the circle radius or the
+	// square side length
+	struct Instance
+	{
+		float x, y;
+		float size;
+		float red, green, blue;
+	};
+
+	// constructor
+	InstancedRenderer();
+	// destructor
+	~InstancedRenderer();
+
+	// create the meshes, buffers and shader programs
+	bool Initialize(
+		const char* vertexShaderPath,
+		const char* fragmentShaderPath,
+		const char* sdfVertexShaderPath,
+		const char* sdfFragmentShaderPath);
+
+	// choose how the circles are drawn
+	void SetCircleMode(CIRCLE_MODE mode) { m_circleMode = mode; }
+	CIRCLE_MODE GetCircleMode() const { return m_circleMode; }
+
+	// set the framebuffer size used for the SDF edge padding
+	void SetViewportSize(int width, int height);
+
+	// map room for count instances of a shape, the returned memory
+	// is write only and valid until UnmapInstances()
+	Instance* MapInstances(SHAPE shape, std::size_t count);
+	void UnmapInstances(SHAPE shape);
+
+	// draw the instances of every shape type
+	void Draw();
+
+private:
+	// the GL data of one shape type
+	struct ShapeBatch
+	{
+		GLuint vao = 0;
+		GLuint meshBuffer = 0;
+		GLuint instanceBuffer = 0;
+		GLenum primitive = GL_TRIANGLE_FAN;
+		GLsizei meshVertices = 0;
+		std::size_t capacity = 0;	// instances the buffer holds
+		std::size_t count = 0;		// instances mapped this frame
+	};
+
+	ShaderManager m_shaderManager;
+	ShapeBatch m_batches[SHAPE_COUNT];
+
+	// the SDF circles share the circle instance buffer
+	ShaderManager m_sdfShaderManager;
+	GLuint m_sdfVao;
+	GLuint m_sdfMeshBuffer;
+	CIRCLE_MODE m_circleMode;
+
+	// create the mesh and instance buffers of one shape type
+	void CreateBatch(
+		ShapeBatch& batch,
+		const float* meshVertices,
+		GLsizei meshVertexCount,
+		GLenum primitive);
+
+	// set the per instance attributes of the bound VAO
+	void SetInstanceAttributes(GLuint instanceBuffer);
+};
@@ -1,5 +1,10 @@
+#include <GL/glew.h>
 #include <GLFW\glfw3.h>
 #include "linmath.h"
+#include "InstancedRenderer.h"
+#include "CircleBenchmark.h"
+#include "CollisionGrid.h"
+#include "Particles.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <conio.h>
@@ -7,6 +12,10 @@
 #include <vector>
 #include <windows.h>
 #include <time.h>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 using namespace std;
 
@@ -31,146 +40,87 @@ public:
 		onoff = ON;
 	};
 
-	void drawBrick()
+	void WriteInstance(InstancedRenderer::Instance& instance) const
 	{
-		if (onoff == ON)
-		{
-			double halfside = width / 2;
+		instance.x = x;
+		instance.y = y;
+		instance.size = width;
+		instance.red = red;
+		instance.green = green;
+		instance.blue = blue;
+	}
+};
 
-			glColor3d(red, green, blue);
-			glBegin(GL_POLYGON);
 
-			glVertex2d(x + halfside, y + halfside);
-			glVertex2d(x + halfside, y - halfside);
-			glVertex2d(x - halfside, y - halfside);
-			glVertex2d(x - halfside, y + halfside);
+Particles::Store world;
+vector<Brick> bricks;
 
-			glEnd();
-		}
-	}
-};
+// circles move this far along each axis per step
+const float CIRCLE_SPEED = 0.03f;
+// the window the circles bounce around in
+const Particles::Bounds WORLD_BOUNDS = { -1, -1, 1, 1 };
 
+// the broad phase, rebuilt every step over the [-1, 1] window
+CollisionGrid circleGrid(-1, -1, 1, 1);
+CollisionGrid brickGrid(-1, -1, 1, 1);
+const float BRICK_CELL_SIZE = 0.05f;
 
-class Circle
-{
-public:
-	float red, green, blue;
-	float radius;
-	float x;
-	float y;
-	float speed = 0.03;
-	int direction; // 1=up 2=right 3=down 4=left 5 = up right   6 = up left  7 = down right  8= down left
+void CheckCollisions();
+void ResolveContact(size_t a, size_t b);
+void RandomVelocity(float& vx, float& vy);
+void AddBrickField(int count);
 
-	Circle(double xx, double yy, double rr, int dir, float rad, float r, float g, float b)
-	{
-		x = xx;
-		y = yy;
-		radius = rr;
-		red = r;
-		green = g;
-		blue = b;
-		radius = rad;
-		direction = dir;
-	}
 
-	void CheckCollision(Brick* brk)
+int main(int argc, char* argv[]) {
+	srand(time(NULL));
+
+	// number of circles to start with, e.g. --circles 1000000
+	int startCircles = 0;
+	// draw the circles as SDF quads instead of polygons
+	bool sdfCircles = false;
+	// time the circle drawing modes and exit
+	bool benchmarkCircles = false;
+	// number of extra small bricks, e.g. --bricks 5000
+	int fieldBricks = 0;
+	// time the particle integration and exit
+	bool benchmarkParticles = false;
+	for (int i = 1; i < argc; i++)
 	{
-		if (brk->brick_type == REFLECTIVE)
+		string argument = argv[i];
+		if (argument == "--circles" && i + 1 < argc)
 		{
-			if ((x > brk->x - brk->width && x <= brk->x + brk->width) && (y > brk->y - brk->width && y <= brk->y + brk->width))
-			{
-				direction = GetRandomDirection();
-				x = x + 0.03;
-				y = y + 0.04;
-			}
+			startCircles = atoi(argv[++i]);
 		}
-		else if (brk->brick_type == DESTRUCTABLE)
+		else if (argument == "--sdf")
 		{
-			if ((x > brk->x - brk->width && x <= brk->x + brk->width) && (y > brk->y - brk->width && y <= brk->y + brk->width))
-			{
-				brk->onoff = OFF;
-			}
-		}
-	}
-
-	int GetRandomDirection()
-	{
-		return (rand() % 8) + 1;
-	}
-
-	void MoveOneStep()
-	{
-		if (direction == 1 || direction == 5 || direction == 6)  // up
-		{
-			if (y > -1 + radius)
-			{
-				y -= speed;
-			}
-			else
-			{
-				direction = GetRandomDirection();
-			}
+			sdfCircles = true;
 		}
-
-		if (direction == 2 || direction == 5 || direction == 7)  // right
+		else if (argument == "--benchmark-circles")
 		{
-			if (x < 1 - radius)
-			{
-				x += speed;
-			}
-			else
-			{
-				direction = GetRandomDirection();
-			}
+			benchmarkCircles = true;
 		}
-
-		if (direction == 3 || direction == 7 || direction == 8)  // down
+		else if (argument == "--bricks" && i + 1 < argc)
 		{
-			if (y < 1 - radius) {
-				y += speed;
-			}
-			else
-			{
-				direction = GetRandomDirection();
-			}
+			fieldBricks = atoi(argv[++i]);
 		}
-
-		if (direction == 4 || direction == 6 || direction == 8)  // left
+		else if (argument == "--benchmark-particles")
 		{
-			if (x > -1 + radius) {
-				x -= speed;
-			}
-			else
-			{
-				direction = GetRandomDirection();
-			}
+			benchmarkParticles = true;
 		}
 	}
 
-	void DrawCircle()
-	{
-		glColor3f(red, green, blue);
-		glBegin(GL_POLYGON);
-		for (int i = 0; i < 360; i++) {
-			float degInRad = i * DEG2RAD;
-			glVertex2f((cos(degInRad) * radius) + x, (sin(degInRad) * radius) + y);
-		}
-		glEnd();
+	if (benchmarkParticles) {
+		Particles::RunBenchmark(startCircles > 0 ? startCircles : 100000, 500);
+		exit(EXIT_SUCCESS);
 	}
-};
-
-
-vector<Circle> world;
-
-
-int main(void) {
-	srand(time(NULL));
 
 	if (!glfwInit()) {
 		exit(EXIT_FAILURE);
 	}
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 	GLFWwindow* window = glfwCreateWindow(480, 480, "8-2 Assignment", NULL, NULL);
 	if (!window) {
 		glfwTerminate();
@@ -179,10 +129,49 @@ int main(void) {
 	glfwMakeContextCurrent(window);
 	glfwSwapInterval(1);
 
-	Brick brick(REFLECTIVE, 0.5, -0.33, 0.2, 1, 1, 0);
-	Brick brick2(DESTRUCTABLE, -0.5, 0.33, 0.2, 0, 1, 0);
-	Brick brick3(DESTRUCTABLE, -0.5, -0.33, 0.2, 0, 1, 1);
-	Brick brick4(REFLECTIVE, 0, 0, 0.2, 1, 0.5, 0.5);
+	glewExperimental = GL_TRUE;
+	if (glewInit() != GLEW_OK) {
+		glfwTerminate();
+		exit(EXIT_FAILURE);
+	}
+
+	InstancedRenderer renderer;
+	if (!renderer.Initialize(
+		"../../Utilities/shaders/instancedVertexShader.glsl",
+		"../../Utilities/shaders/instancedFragmentShader.glsl",
+		"../../Utilities/shaders/sdfCircleVertexShader.glsl",
+		"../../Utilities/shaders/sdfCircleFragmentShader.glsl")) {
+		glfwTerminate();
+		exit(EXIT_FAILURE);
+	}
+	renderer.SetCircleMode(sdfCircles ? InstancedRenderer::SDF_CIRCLES : InstancedRenderer::POLYGON_CIRCLES);
+
+	if (benchmarkCircles) {
+		int width, height;
+		glfwGetFramebufferSize(window, &width, &height);
+		RunCircleBenchmark(renderer, width, height);
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		exit(EXIT_SUCCESS);
+	}
+
+	for (int i = 0; i < startCircles; i++)
+	{
+		float r = (rand() % 256) / 255.0f;
+		float g = (rand() % 256) / 255.0f;
+		float b = (rand() % 256) / 255.0f;
+		float x = ((rand() % 2001) - 1000) / 1000.0f * 0.95f;
+		float y = ((rand() % 2001) - 1000) / 1000.0f * 0.95f;
+		float vx, vy;
+		RandomVelocity(vx, vy);
+		world.Add(x, y, vx, vy, 0.005, r, g, b);
+	}
+
+	bricks.push_back(Brick(REFLECTIVE, 0.5, -0.33, 0.2, 1, 1, 0));
+	bricks.push_back(Brick(DESTRUCTABLE, -0.5, 0.33, 0.2, 0, 1, 0));
+	bricks.push_back(Brick(DESTRUCTABLE, -0.5, -0.33, 0.2, 0, 1, 1));
+	bricks.push_back(Brick(REFLECTIVE, 0, 0, 0.2, 1, 0.5, 0.5));
+	AddBrickField(fieldBricks);
 
 	while (!glfwWindowShouldClose(window)) {
 		//Setup View
@@ -191,37 +180,187 @@ int main(void) {
 		glfwGetFramebufferSize(window, &width, &height);
 		ratio = width / (float)height;
 		glViewport(0, 0, width, height);
+		renderer.SetViewportSize(width, height);
 		glClear(GL_COLOR_BUFFER_BIT);
 
 		processInput(window);
 
 		//Movement
-		for (int i = 0; i < world.size(); i++)
+		CheckCollisions();
+		Particles::Integrate(world, 1, WORLD_BOUNDS, 0, world.Size());
+		InstancedRenderer::Instance* circles = renderer.MapInstances(InstancedRenderer::CIRCLE, world.Size());
+		for (size_t i = 0; i < world.Size(); i++)
 		{
-			world[i].CheckCollision(&brick);
-			world[i].CheckCollision(&brick2);
-			world[i].CheckCollision(&brick3);
-			world[i].CheckCollision(&brick4);
-			world[i].MoveOneStep();
-			world[i].DrawCircle();
+			circles[i].x = world.x[i];
+			circles[i].y = world.y[i];
+			circles[i].size = world.radius[i];
+			circles[i].red = world.red[i];
+			circles[i].green = world.green[i];
+			circles[i].blue = world.blue[i];
+		}
+		renderer.UnmapInstances(InstancedRenderer::CIRCLE);
 
+		int bricksOn = 0;
+		for (const Brick& brk : bricks)
+		{
+			bricksOn += (brk.onoff == ON) ? 1 : 0;
 		}
+		InstancedRenderer::Instance* squares = renderer.MapInstances(InstancedRenderer::SQUARE, bricksOn);
+		for (const Brick& brk : bricks)
+		{
+			if (brk.onoff == ON)
+			{
+				brk.WriteInstance(*squares++);
+			}
+		}
+		renderer.UnmapInstances(InstancedRenderer::SQUARE);
 
-		brick.drawBrick();
-		brick2.drawBrick();
-		brick3.drawBrick();
-		brick4.drawBrick();
+		renderer.Draw();
 
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
 
 	glfwDestroyWindow(window);
-	glfwTerminate;
+	glfwTerminate();
 	exit(EXIT_SUCCESS);
 }
 
 
+// test every circle against the bricks under it and the circles
+// near it, using the grids instead of testing all against all
+void CheckCollisions()
+{
+	static vector<float> x, y, extent;
+	static vector<uint32_t> ids;
+	static vector<CollisionGrid::Pair> pairs;
+
+	// circle against circle, the grid reads the arrays directly
+	float largest = 0;
+	for (float radius : world.radius)
+	{
+		largest = max(largest, radius);
+	}
+	circleGrid.SetCellSize(2 * largest);
+	circleGrid.Build(world.x.data(), world.y.data(), world.radius.data(), NULL, world.Size());
+	pairs.clear();
+	circleGrid.FindPairs(pairs);
+	for (const CollisionGrid::Pair& pair : pairs)
+	{
+		ResolveContact(pair.first, pair.second);
+	}
+
+	// circle against the bricks that are still on
+	x.clear();
+	y.clear();
+	extent.clear();
+	ids.clear();
+	for (size_t i = 0; i < bricks.size(); i++)
+	{
+		if (bricks[i].onoff == ON)
+		{
+			x.push_back(bricks[i].x);
+			y.push_back(bricks[i].y);
+			extent.push_back(bricks[i].width);
+			ids.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	brickGrid.SetCellSize(BRICK_CELL_SIZE);
+	brickGrid.Build(x.data(), y.data(), extent.data(), ids.data(), ids.size());
+	for (size_t i = 0; i < world.Size(); i++)
+	{
+		size_t count;
+		const CollisionGrid::Entry* candidates = brickGrid.Query(world.x[i], world.y[i], count);
+		for (size_t c = 0; c < count; c++)
+		{
+			Brick* brk = &bricks[candidates[c].id];
+			float cx = world.x[i];
+			float cy = world.y[i];
+			if ((cx > brk->x - brk->width && cx <= brk->x + brk->width) && (cy > brk->y - brk->width && cy <= brk->y + brk->width))
+			{
+				if (brk->brick_type == REFLECTIVE)
+				{
+					RandomVelocity(world.vx[i], world.vy[i]);
+					world.x[i] += 0.03f;
+					world.y[i] += 0.04f;
+				}
+				else if (brk->brick_type == DESTRUCTABLE)
+				{
+					brk->onoff = OFF;
+				}
+			}
+		}
+	}
+}
+
+// push two overlapping circles apart and exchange their velocities
+// along the line between the centers, an elastic hit between equal
+// masses
+void ResolveContact(size_t a, size_t b)
+{
+	float dx = world.x[b] - world.x[a];
+	float dy = world.y[b] - world.y[a];
+	float reach = world.radius[a] + world.radius[b];
+	float distanceSquared = dx * dx + dy * dy;
+	if (distanceSquared >= reach * reach || distanceSquared == 0)
+	{
+		return;
+	}
+
+	float distance = sqrt(distanceSquared);
+	float nx = dx / distance;
+	float ny = dy / distance;
+	float push = 0.5f * (reach - distance);
+	world.x[a] -= nx * push;
+	world.y[a] -= ny * push;
+	world.x[b] += nx * push;
+	world.y[b] += ny * push;
+
+	// only exchange when the circles are closing in
+	float closing = (world.vx[a] - world.vx[b]) * nx + (world.vy[a] - world.vy[b]) * ny;
+	if (closing > 0)
+	{
+		world.vx[a] -= closing * nx;
+		world.vy[a] -= closing * ny;
+		world.vx[b] += closing * nx;
+		world.vy[b] += closing * ny;
+	}
+}
+
+// one of the eight old directions, at the circle speed
+void RandomVelocity(float& vx, float& vy)
+{
+	Particles::DirectionVelocity((rand() % 8) + 1, CIRCLE_SPEED, vx, vy);
+}
+
+// lay out count small bricks in rows across the window, alternating
+// between reflective and destructable
+void AddBrickField(int count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	int columns = static_cast<int>(ceil(sqrt(static_cast<double>(count))));
+	float spacing = 1.9f / columns;
+	float width = 0.25f * spacing;
+	for (int i = 0; i < count; i++)
+	{
+		float bx = -0.95f + spacing * (i % columns + 0.5f);
+		float by = -0.95f + spacing * (i / columns + 0.5f);
+		if (i % 2 == 0)
+		{
+			bricks.push_back(Brick(REFLECTIVE, bx, by, width, 1, 1, 0));
+		}
+		else
+		{
+			bricks.push_back(Brick(DESTRUCTABLE, bx, by, width, 0, 1, 0));
+		}
+	}
+}
+
+
 void processInput(GLFWwindow* window)
 {
 	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
@@ -233,7 +372,6 @@ void processInput(GLFWwindow* window)
 		r = rand() / 10000;
 		g = rand() / 10000;
 		b = rand() / 10000;
-		Circle B(0, 0, 02, 2, 0.05, r, g, b);
-		world.push_back(B);
+		world.Add(0, 0, CIRCLE_SPEED, 0, 0.05, r, g, b);
 	}
 }
\ No newline at end of file
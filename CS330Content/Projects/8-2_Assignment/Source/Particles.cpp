@@ -0,0 +1,346 @@
+///////////////////////////////////////////////////////////////////////////////
+// particles.cpp
+// ============
+// structure of arrays storage and integration for the circles of the
+// simulation
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Particles.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef PARTICLES_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	/***********************************************************
+	 *  LegacyCircle
+	 *
+	 *  The circle object the store replaced, with the position
+	 *  update of the original main loop.  It is only kept as
+	 *  the baseline of the benchmark.
+	 ***********************************************************/
+	struct LegacyCircle
+	{
+		float red, green, blue;
+		float radius;
+		float x;
+		float y;
+		float speed = 0.03f;
+		int direction;
+
+		int GetRandomDirection()
+		{
+			return (rand() % 8) + 1;
+		}
+
+		void MoveOneStep()
+		{
+			if (direction == 1 || direction == 5 || direction == 6)  // up
+			{
+				if (y > -1 + radius)
+				{
+					y -= speed;
+				}
+				else
+				{
+					direction = GetRandomDirection();
+				}
+			}
+
+			if (direction == 2 || direction == 5 || direction == 7)  // right
+			{
+				if (x < 1 - radius)
+				{
+					x += speed;
+				}
+				else
+				{
+					direction = GetRandomDirection();
+				}
+			}
+
+			if (direction == 3 || direction == 7 || direction == 8)  // down
+			{
+				if (y < 1 - radius)
+				{
+					y += speed;
+				}
+				else
+				{
+					direction = GetRandomDirection();
+				}
+			}
+
+			if (direction == 4 || direction == 6 || direction == 8)  // left
+			{
+				if (x > -1 + radius)
+				{
+					x -= speed;
+				}
+				else
+				{
+					direction = GetRandomDirection();
+				}
+			}
+		}
+	};
+
+	/***********************************************************
+	 *  ReflectAxis()
+	 *
+	 *  Move one coordinate by its velocity and mirror it back
+	 *  into [low, high] if it left, with the velocity turned
+	 *  to point back inside.
+	 ***********************************************************/
+	inline void ReflectAxis(float& position, float& velocity, float dt, float low, float high)
+	{
+		float p = position + velocity * dt;
+		float speed = std::fabs(velocity);
+		float v = (p < low) ? speed : velocity;
+		v = (p > high) ? -speed : v;
+		position = std::min(std::max(p, (low + low) - p), (high + high) - p);
+		velocity = v;
+	}
+
+#ifdef PARTICLES_AVX2
+	/***********************************************************
+	 *  ReflectAxis8()
+	 *
+	 *  ReflectAxis() for eight circles, with the comparisons
+	 *  turned into masks that select the sign of the velocity.
+	 ***********************************************************/
+	inline void ReflectAxis8(
+		float* position,
+		float* velocity,
+		const float* radius,
+		__m256 dt,
+		__m256 minimum,
+		__m256 maximum)
+	{
+		const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+		__m256 r = _mm256_loadu_ps(radius);
+		__m256 low = _mm256_add_ps(minimum, r);
+		__m256 high = _mm256_sub_ps(maximum, r);
+		__m256 v = _mm256_loadu_ps(velocity);
+		__m256 p = _mm256_add_ps(_mm256_loadu_ps(position), _mm256_mul_ps(v, dt));
+
+		__m256 under = _mm256_cmp_ps(p, low, _CMP_LT_OQ);
+		__m256 over = _mm256_cmp_ps(p, high, _CMP_GT_OQ);
+		__m256 speed = _mm256_andnot_ps(signBit, v);
+		v = _mm256_blendv_ps(v, speed, under);
+		v = _mm256_blendv_ps(v, _mm256_or_ps(speed, signBit), over);
+
+		p = _mm256_max_ps(p, _mm256_sub_ps(_mm256_add_ps(low, low), p));
+		p = _mm256_min_ps(p, _mm256_sub_ps(_mm256_add_ps(high, high), p));
+
+		_mm256_storeu_ps(position, p);
+		_mm256_storeu_ps(velocity, v);
+	}
+#endif
+
+	// seconds taken by a function
+	template <typename Function>
+	double Time(Function function)
+	{
+		auto start = std::chrono::steady_clock::now();
+		function();
+		return(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+}
+
+namespace Particles
+{
+	/***********************************************************
+	 *  Store::Add()
+	 *
+	 *  Append one circle to every array.
+	 ***********************************************************/
+	void Store::Add(float px, float py, float velocityX, float velocityY, float r, float cr, float cg, float cb)
+	{
+		x.push_back(px);
+		y.push_back(py);
+		vx.push_back(velocityX);
+		vy.push_back(velocityY);
+		radius.push_back(r);
+		red.push_back(cr);
+		green.push_back(cg);
+		blue.push_back(cb);
+	}
+
+	/***********************************************************
+	 *  Store::Reserve()
+	 *
+	 *  Make room in every array for count circles.
+	 ***********************************************************/
+	void Store::Reserve(std::size_t count)
+	{
+		x.reserve(count);
+		y.reserve(count);
+		vx.reserve(count);
+		vy.reserve(count);
+		radius.reserve(count);
+		red.reserve(count);
+		green.reserve(count);
+		blue.reserve(count);
+	}
+
+	/***********************************************************
+	 *  Store::Clear()
+	 *
+	 *  Remove every circle, keeping the memory.
+	 ***********************************************************/
+	void Store::Clear()
+	{
+		x.clear();
+		y.clear();
+		vx.clear();
+		vy.clear();
+		radius.clear();
+		red.clear();
+		green.clear();
+		blue.clear();
+	}
+
+	/***********************************************************
+	 *  DirectionVelocity()
+	 *
+	 *  Convert one of the old direction codes into a velocity,
+	 *  a diagonal moves by speed along both axes as before.
+	 ***********************************************************/
+	void DirectionVelocity(int direction, float speed, float& velocityX, float& velocityY)
+	{
+		static const float directions[9][2] = {
+			{ 0, 0 },
+			{ 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 },
+			{ 1, -1 }, { -1, -1 }, { 1, 1 }, { -1, 1 },
+		};
+		if (direction < 1 || direction > 8)
+		{
+			direction = 0;
+		}
+		velocityX = directions[direction][0] * speed;
+		velocityY = directions[direction][1] * speed;
+	}
+
+	/***********************************************************
+	 *  IntegrateScalar()
+	 *
+	 *  Step circles [first, end) one at a time.
+	 ***********************************************************/
+	void IntegrateScalar(Store& store, float dt, const Bounds& bounds, std::size_t first, std::size_t end)
+	{
+		for (std::size_t i = first; i < end; i++)
+		{
+			float r = store.radius[i];
+			ReflectAxis(store.x[i], store.vx[i], dt, bounds.minX + r, bounds.maxX - r);
+			ReflectAxis(store.y[i], store.vy[i], dt, bounds.minY + r, bounds.maxY - r);
+		}
+	}
+
+	/***********************************************************
+	 *  Integrate()
+	 *
+	 *  Step circles [first, end), eight at a time when AVX2 is
+	 *  available, and the remainder one at a time.
+	 ***********************************************************/
+	void Integrate(Store& store, float dt, const Bounds& bounds, std::size_t first, std::size_t end)
+	{
+		std::size_t i = first;
+#ifdef PARTICLES_AVX2
+		const __m256 step = _mm256_set1_ps(dt);
+		const __m256 minX = _mm256_set1_ps(bounds.minX);
+		const __m256 maxX = _mm256_set1_ps(bounds.maxX);
+		const __m256 minY = _mm256_set1_ps(bounds.minY);
+		const __m256 maxY = _mm256_set1_ps(bounds.maxY);
+		for (; i + 8 <= end; i += 8)
+		{
+			ReflectAxis8(&store.x[i], &store.vx[i], &store.radius[i], step, minX, maxX);
+			ReflectAxis8(&store.y[i], &store.vy[i], &store.radius[i], step, minY, maxY);
+		}
+#endif
+		IntegrateScalar(store, dt, bounds, i, end);
+	}
+
+	/***********************************************************
+	 *  RunBenchmark()
+	 *
+	 *  Step the same circles with the old object loop, the
+	 *  scalar store loop and the vectorized store loop on one
+	 *  thread, and report the steps per second of each.
+	 ***********************************************************/
+	void RunBenchmark(std::size_t count, int steps)
+	{
+		const float speed = 0.03f;
+		const Bounds bounds = { -1.0f, -1.0f, 1.0f, 1.0f };
+
+		srand(1);
+		std::vector<LegacyCircle> objects(count);
+		Store scalar;
+		scalar.Reserve(count);
+		for (LegacyCircle& circle : objects)
+		{
+			circle.x = ((rand() % 2001) - 1000) / 1000.0f * 0.95f;
+			circle.y = ((rand() % 2001) - 1000) / 1000.0f * 0.95f;
+			circle.radius = 0.005f;
+			circle.red = circle.green = circle.blue = 1.0f;
+			circle.direction = (rand() % 8) + 1;
+
+			float velocityX, velocityY;
+			DirectionVelocity(circle.direction, speed, velocityX, velocityY);
+			scalar.Add(circle.x, circle.y, velocityX, velocityY, circle.radius, 1.0f, 1.0f, 1.0f);
+		}
+		Store vectorized = scalar;
+
+		double objectSeconds = Time([&]() {
+			for (int s = 0; s < steps; s++)
+			{
+				for (LegacyCircle& circle : objects)
+				{
+					circle.MoveOneStep();
+				}
+			}
+		});
+		double scalarSeconds = Time([&]() {
+			for (int s = 0; s < steps; s++)
+			{
+				IntegrateScalar(scalar, 1.0f, bounds, 0, scalar.Size());
+			}
+		});
+		double vectorSeconds = Time([&]() {
+			for (int s = 0; s < steps; s++)
+			{
+				Integrate(vectorized, 1.0f, bounds, 0, vectorized.Size());
+			}
+		});
+
+		bool identical =
+			0 == std::memcmp(scalar.x.data(), vectorized.x.data(), count * sizeof(float)) &&
+			0 == std::memcmp(scalar.y.data(), vectorized.y.data(), count * sizeof(float)) &&
+			0 == std::memcmp(scalar.vx.data(), vectorized.vx.data(), count * sizeof(float)) &&
+			0 == std::memcmp(scalar.vy.data(), vectorized.vy.data(), count * sizeof(float));
+
+		std::cout << "Particle integration, " << count << " circles, " << steps << " steps, one thread:\n";
+		std::cout << "  object loop:     " << steps / objectSeconds << " steps/s, "
+			<< (count * steps / objectSeconds) / 1.0e6 << " M circle steps/s\n";
+		std::cout << "  arrays, scalar:  " << steps / scalarSeconds << " steps/s, "
+			<< (count * steps / scalarSeconds) / 1.0e6 << " M circle steps/s\n";
+		std::cout << "  arrays, "
+#ifdef PARTICLES_AVX2
+			<< "AVX2:    "
+#else
+			<< "no AVX2: "
+#endif
+			<< steps / vectorSeconds << " steps/s, "
+			<< (count * steps / vectorSeconds) / 1.0e6 << " M circle steps/s\n";
+		std::cout << "  vectorized matches scalar: " << (identical ? "yes" : "NO") << std::endl;
+	}
+}
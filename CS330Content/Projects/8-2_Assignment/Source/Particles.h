@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// particles.h
+// ============
+// structure of arrays storage and integration for the circles of the
+// simulation
+//
+//  Every attribute of the circles is kept in its own flat array, so a
+//  step only streams through the arrays it uses.  Circles move with a
+//  velocity vector instead of a direction code, and integration and
+//  wall reflection have no branches: the reflected position is a
+//  min/max of mirror images and the velocity takes the sign that points
+//  back into the box.  Eight circles are stepped at once with AVX2 when
+//  the compiler targets it.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__AVX2__)
+#define PARTICLES_AVX2 1
+#endif
+
+namespace Particles
+{
+	// the circles, one entry per circle in every array
+	struct Store
+	{
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> vx;			// distance per step along x
+		std::vector<float> vy;			// distance per step along y
+		std::vector<float> radius;
+		std::vector<float> red;
+		std::vector<float> green;
+		std::vector<float> blue;
+
+		void Add(float px, float py, float velocityX, float velocityY, float r, float cr, float cg, float cb);
+		void Reserve(std::size_t count);
+		void Clear();
+		std::size_t Size() const { return x.size(); }
+	};
+
+	// the box the circles bounce around in
+	struct Bounds
+	{
+		float minX, minY;
+		float maxX, maxY;
+	};
+
+	// the velocity of the old direction codes, 1 = up, 2 = right,
+	// 3 = down, 4 = left, 5 = up right, 6 = up left, 7 = down right,
+	// 8 = down left, where up is toward -y
+	void DirectionVelocity(int direction, float speed, float& velocityX, float& velocityY);
+
+	// advance circles [first, end) by dt steps and reflect them off the
+	// walls of the box, one at a time
+	void IntegrateScalar(Store& store, float dt, const Bounds& bounds, std::size_t first, std::size_t end);
+
+	// the same, eight at a time when AVX2 is available, the results
+	// are identical to IntegrateScalar()
+	void Integrate(Store& store, float dt, const Bounds& bounds, std::size_t first, std::size_t end);
+
+	// time the object loop the store replaced against the scalar and
+	// vectorized integration, printed to standard output
+	void RunBenchmark(std::size_t count, int steps);
+}
@@ -0,0 +1,417 @@
+///////////////////////////////////////////////////////////////////////////////
+// simulation.cpp
+// ============
+// the circles and bricks of the 8-2 world and the fixed step that moves
+// them, with no window or OpenGL dependency
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	// side of the cells of the brick grid
+	const float g_BrickCellSize = 0.05f;
+	// radius of the circles placed by Populate()
+	const float g_SmallRadius = 0.005f;
+
+	// true when two arrays hold the same bits
+	bool SameFloats(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		return(a.size() == b.size() &&
+			(a.empty() || 0 == std::memcmp(a.data(), b.data(), a.size() * sizeof(float))));
+	}
+}
+
+const float Simulation::CIRCLE_SPEED = 0.03f;
+
+/***********************************************************
+ *  Simulation()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+Simulation::Simulation() :
+	m_circleGrid(-1, -1, 1, 1),
+	m_brickGrid(-1, -1, 1, 1)
+{
+	m_bounds.minX = -1;
+	m_bounds.minY = -1;
+	m_bounds.maxX = 1;
+	m_bounds.maxY = 1;
+	m_stepCount = 0;
+	m_stats = StepStats();
+	m_brickGrid.SetCellSize(g_BrickCellSize);
+
+	SetThreadCount(1);
+}
+
+/***********************************************************
+ *  SetThreadCount()
+ *
+ *  This method is used for choosing how many threads run
+ *  the phases of a step.  The result of a step does not
+ *  depend on it.
+ ***********************************************************/
+void Simulation::SetThreadCount(int threads)
+{
+	m_pool.reset();
+	m_pool.reset(new ThreadPool(threads));
+	m_workers.assign(m_pool->GetThreadCount(), WorkerResults());
+}
+
+/***********************************************************
+ *  Populate()
+ *
+ *  This method is used for setting up the starting world:
+ *  the four original bricks, an optional field of small
+ *  bricks and randomly placed small circles.
+ ***********************************************************/
+void Simulation::Populate(std::size_t circles, int fieldBricks)
+{
+	m_bricks.push_back(Brick(REFLECTIVE, 0.5, -0.33, 0.2, 1, 1, 0));
+	m_bricks.push_back(Brick(DESTRUCTABLE, -0.5, 0.33, 0.2, 0, 1, 0));
+	m_bricks.push_back(Brick(DESTRUCTABLE, -0.5, -0.33, 0.2, 0, 1, 1));
+	m_bricks.push_back(Brick(REFLECTIVE, 0, 0, 0.2, 1, 0.5, 0.5));
+	AddBrickField(fieldBricks);
+
+	m_circles.Reserve(m_circles.Size() + circles);
+	for (std::size_t i = 0; i < circles; i++)
+	{
+		float r = (rand() % 256) / 255.0f;
+		float g = (rand() % 256) / 255.0f;
+		float b = (rand() % 256) / 255.0f;
+		float x = ((rand() % 2001) - 1000) / 1000.0f * 0.95f;
+		float y = ((rand() % 2001) - 1000) / 1000.0f * 0.95f;
+		float vx, vy;
+		RandomVelocity(vx, vy);
+		m_circles.Add(x, y, vx, vy, g_SmallRadius, r, g, b);
+	}
+}
+
+/***********************************************************
+ *  AddBrickField()
+ *
+ *  This method is used for laying out count small bricks
+ *  in rows, alternating between reflective (yellow) and
+ *  destructable (green).
+ ***********************************************************/
+void Simulation::AddBrickField(int count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+	float spacing = 1.9f / columns;
+	float width = 0.25f * spacing;
+	for (int i = 0; i < count; i++)
+	{
+		float bx = -0.95f + spacing * (i % columns + 0.5f);
+		float by = -0.95f + spacing * (i / columns + 0.5f);
+		if (i % 2 == 0)
+		{
+			m_bricks.push_back(Brick(REFLECTIVE, bx, by, width, 1, 1, 0));
+		}
+		else
+		{
+			m_bricks.push_back(Brick(DESTRUCTABLE, bx, by, width, 0, 1, 0));
+		}
+	}
+}
+
+/***********************************************************
+ *  RandomVelocity()
+ *
+ *  This method is used for picking one of the eight old
+ *  directions at the circle speed.
+ ***********************************************************/
+void Simulation::RandomVelocity(float& vx, float& vy)
+{
+	Particles::DirectionVelocity((rand() % 8) + 1, CIRCLE_SPEED, vx, vy);
+}
+
+/***********************************************************
+ *  Step()
+ *
+ *  This method is used for advancing the world by one step:
+ *  circle contacts, brick hits, then integration.
+ ***********************************************************/
+void Simulation::Step()
+{
+	m_stats = StepStats();
+
+	CollideCircles();
+	CollideBricks();
+	ApplyBrickHits();
+
+	// whole groups of eight per worker, so only the last part has
+	// a scalar remainder
+	std::size_t count = m_circles.Size();
+	m_pool->ParallelFor((count + 7) / 8, [&](std::size_t first, std::size_t end, int) {
+		Particles::Integrate(m_circles, 1, m_bounds, first * 8, std::min(end * 8, count));
+	});
+
+	m_stepCount++;
+}
+
+/***********************************************************
+ *  CollideCircles()
+ *
+ *  This method is used for pushing touching circles apart.
+ *  The pairs are found in parallel over ranges of grid
+ *  cells and kept in cell order.  Every contact is worked
+ *  out from the state before the phase, in parallel, and
+ *  the changes are added up in pair order.
+ ***********************************************************/
+void Simulation::CollideCircles()
+{
+	std::size_t count = m_circles.Size();
+	for (WorkerResults& worker : m_workers)
+	{
+		worker.pairs.clear();
+		worker.pairTests = 0;
+		worker.contacts = 0;
+		worker.largestRadius = 0;
+	}
+
+	m_pool->ParallelFor(count, [&](std::size_t first, std::size_t end, int worker) {
+		float largest = 0;
+		for (std::size_t i = first; i < end; i++)
+		{
+			largest = std::max(largest, m_circles.radius[i]);
+		}
+		m_workers[worker].largestRadius = largest;
+	});
+	float largest = 0;
+	for (const WorkerResults& worker : m_workers)
+	{
+		largest = std::max(largest, worker.largestRadius);
+	}
+
+	m_circleGrid.SetCellSize(2 * largest);
+	m_circleGrid.Build(m_circles.x.data(), m_circles.y.data(), m_circles.radius.data(), NULL, count);
+
+	m_pool->ParallelFor(m_circleGrid.GetCellCount(), [&](std::size_t first, std::size_t end, int worker) {
+		m_workers[worker].pairTests += m_circleGrid.FindPairs(first, end, m_workers[worker].pairs);
+	});
+	m_pairs.clear();
+	for (const WorkerResults& worker : m_workers)
+	{
+		m_pairs.insert(m_pairs.end(), worker.pairs.begin(), worker.pairs.end());
+		m_stats.pairTests += worker.pairTests;
+	}
+
+	m_deltas.resize(m_pairs.size());
+	m_pool->ParallelFor(m_pairs.size(), [&](std::size_t first, std::size_t end, int worker) {
+		const Particles::Store& c = m_circles;
+		for (std::size_t p = first; p < end; p++)
+		{
+			std::uint32_t a = m_pairs[p].first;
+			std::uint32_t b = m_pairs[p].second;
+			ContactDelta& delta = m_deltas[p];
+			delta = ContactDelta();
+
+			float dx = c.x[b] - c.x[a];
+			float dy = c.y[b] - c.y[a];
+			float reach = c.radius[a] + c.radius[b];
+			float distanceSquared = dx * dx + dy * dy;
+			if (distanceSquared >= reach * reach || distanceSquared == 0)
+			{
+				continue;
+			}
+			m_workers[worker].contacts++;
+
+			float distance = std::sqrt(distanceSquared);
+			float nx = dx / distance;
+			float ny = dy / distance;
+			float push = 0.5f * (reach - distance);
+			delta.x = nx * push;
+			delta.y = ny * push;
+
+			// only exchange velocity when the circles are closing in,
+			// an elastic hit between equal masses
+			float closing = (c.vx[a] - c.vx[b]) * nx + (c.vy[a] - c.vy[b]) * ny;
+			if (closing > 0)
+			{
+				delta.vx = closing * nx;
+				delta.vy = closing * ny;
+			}
+		}
+	});
+
+	for (std::size_t p = 0; p < m_pairs.size(); p++)
+	{
+		std::uint32_t a = m_pairs[p].first;
+		std::uint32_t b = m_pairs[p].second;
+		const ContactDelta& delta = m_deltas[p];
+		m_circles.x[a] -= delta.x;
+		m_circles.y[a] -= delta.y;
+		m_circles.vx[a] -= delta.vx;
+		m_circles.vy[a] -= delta.vy;
+		m_circles.x[b] += delta.x;
+		m_circles.y[b] += delta.y;
+		m_circles.vx[b] += delta.vx;
+		m_circles.vy[b] += delta.vy;
+	}
+	for (const WorkerResults& worker : m_workers)
+	{
+		m_stats.contacts += worker.contacts;
+	}
+}
+
+/***********************************************************
+ *  CollideBricks()
+ *
+ *  This method is used for testing every circle against the
+ *  bricks under its center, in parallel over ranges of
+ *  circles.  Hits only touch the circle itself; the random
+ *  bounces and destroyed bricks are recorded per worker.
+ ***********************************************************/
+void Simulation::CollideBricks()
+{
+	m_brickX.clear();
+	m_brickY.clear();
+	m_brickExtent.clear();
+	m_brickIds.clear();
+	for (std::size_t i = 0; i < m_bricks.size(); i++)
+	{
+		if (m_bricks[i].onoff == ON)
+		{
+			m_brickX.push_back(m_bricks[i].x);
+			m_brickY.push_back(m_bricks[i].y);
+			m_brickExtent.push_back(m_bricks[i].width);
+			m_brickIds.push_back(static_cast<std::uint32_t>(i));
+		}
+	}
+	m_brickGrid.Build(m_brickX.data(), m_brickY.data(), m_brickExtent.data(), m_brickIds.data(), m_brickIds.size());
+
+	for (WorkerResults& worker : m_workers)
+	{
+		worker.bounced.clear();
+		worker.destroyed.clear();
+		worker.brickTests = 0;
+	}
+
+	m_pool->ParallelFor(m_circles.Size(), [&](std::size_t first, std::size_t end, int worker) {
+		WorkerResults& results = m_workers[worker];
+		for (std::size_t i = first; i < end; i++)
+		{
+			std::size_t count;
+			const CollisionGrid::Entry* candidates = m_brickGrid.Query(m_circles.x[i], m_circles.y[i], count);
+			results.brickTests += count;
+			for (std::size_t c = 0; c < count; c++)
+			{
+				const Brick& brk = m_bricks[candidates[c].id];
+				float cx = m_circles.x[i];
+				float cy = m_circles.y[i];
+				if ((cx > brk.x - brk.width && cx <= brk.x + brk.width) && (cy > brk.y - brk.width && cy <= brk.y + brk.width))
+				{
+					if (brk.brick_type == REFLECTIVE)
+					{
+						results.bounced.push_back(static_cast<std::uint32_t>(i));
+						m_circles.x[i] += 0.03f;
+						m_circles.y[i] += 0.04f;
+					}
+					else if (brk.brick_type == DESTRUCTABLE)
+					{
+						results.destroyed.push_back(candidates[c].id);
+					}
+				}
+			}
+		}
+	});
+}
+
+/***********************************************************
+ *  ApplyBrickHits()
+ *
+ *  This method is used for merging the brick hits of the
+ *  workers.  Worker parts are contiguous and in order, so
+ *  walking the workers in order visits the circles in index
+ *  order for any number of threads.
+ ***********************************************************/
+void Simulation::ApplyBrickHits()
+{
+	for (const WorkerResults& worker : m_workers)
+	{
+		m_stats.brickTests += worker.brickTests;
+		for (std::uint32_t circle : worker.bounced)
+		{
+			RandomVelocity(m_circles.vx[circle], m_circles.vy[circle]);
+		}
+		for (std::uint32_t brick : worker.destroyed)
+		{
+			m_bricks[brick].onoff = OFF;
+		}
+		m_stats.brickHits += worker.bounced.size() + worker.destroyed.size();
+	}
+}
+
+/***********************************************************
+ *  SameState()
+ *
+ *  This method is used for comparing two worlds bit for bit.
+ ***********************************************************/
+bool Simulation::SameState(const Simulation& other) const
+{
+	if (m_stepCount != other.m_stepCount || m_bricks.size() != other.m_bricks.size())
+	{
+		return(false);
+	}
+	for (std::size_t i = 0; i < m_bricks.size(); i++)
+	{
+		if (m_bricks[i].onoff != other.m_bricks[i].onoff)
+		{
+			return(false);
+		}
+	}
+
+	const Particles::Store& a = m_circles;
+	const Particles::Store& b = other.m_circles;
+	return(SameFloats(a.x, b.x) && SameFloats(a.y, b.y) &&
+		SameFloats(a.vx, b.vx) && SameFloats(a.vy, b.vy) &&
+		SameFloats(a.radius, b.radius) &&
+		SameFloats(a.red, b.red) && SameFloats(a.green, b.green) && SameFloats(a.blue, b.blue));
+}
+
+/***********************************************************
+ *  RunThreadComparison()
+ *
+ *  Set up the same world twice, step one copy on a single
+ *  thread and the other on several, and report whether the
+ *  two end states are identical.
+ ***********************************************************/
+bool RunThreadComparison(std::size_t circles, int fieldBricks, int steps, int threads)
+{
+	double seconds[2];
+	Simulation worlds[2];
+	for (int w = 0; w < 2; w++)
+	{
+		srand(1);
+		worlds[w].SetThreadCount(w == 0 ? 1 : threads);
+		worlds[w].Populate(circles, fieldBricks);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int s = 0; s < steps; s++)
+		{
+			worlds[w].Step();
+		}
+		seconds[w] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	bool same = worlds[0].SameState(worlds[1]);
+	std::cout << "Thread comparison, " << circles << " circles, " << worlds[0].GetBricks().size()
+		<< " bricks, " << steps << " steps:\n";
+	std::cout << "  1 thread:   " << 1000.0 * seconds[0] / steps << " ms/step\n";
+	std::cout << "  " << worlds[1].GetThreadCount() << " threads:  " << 1000.0 * seconds[1] / steps
+		<< " ms/step (" << seconds[0] / seconds[1] << "x)\n";
+	std::cout << "  states identical: " << (same ? "yes" : "NO") << std::endl;
+	return(same);
+}
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// simulation.h
+// ============
+// the circles and bricks of the 8-2 world and the fixed step that moves
+// them, with no window or OpenGL dependency
+//
+//  A step is split into phases that each run over contiguous ranges of
+//  grid cells, contact pairs or circles on a thread pool.  Work that
+//  needs a shared order, the contact impulses, the random bounces off
+//  reflective bricks and the destroyed bricks, is gathered per worker
+//  and applied afterwards in index order, so the state after a step is
+//  bit-identical for any number of threads.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CollisionGrid.h"
+#include "Particles.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum BRICKTYPE { REFLECTIVE, DESTRUCTABLE };
+enum ONOFF { ON, OFF };
+
+class Brick
+{
+public:
+	float red, green, blue;
+	float x, y, width;
+	BRICKTYPE brick_type;
+	ONOFF onoff;
+
+	Brick(BRICKTYPE bt, float xx, float yy, float ww, float rr, float gg, float bb)
+	{
+		brick_type = bt; x = xx; y = yy, width = ww; red = rr, green = gg, blue = bb;
+		onoff = ON;
+	};
+};
+
+/***********************************************************
+ *  Simulation
+ *
+ *  This class contains the code for stepping the circles
+ *  and bricks of the world on one or more threads.
+ ***********************************************************/
+class Simulation
+{
+public:
+	// circles move this far along each axis per step
+	static const float CIRCLE_SPEED;
+
+	// work done by the last step
+	struct StepStats
+	{
+		std::size_t pairTests;		// circle pairs compared in the grid
+		std::size_t contacts;		// circle pairs that touched
+		std::size_t brickTests;		// circle and brick comparisons
+		std::size_t brickHits;		// circles inside a brick
+	};
+
+	// constructor
+	Simulation();
+
+	// use this many threads, zero for one per hardware thread
+	void SetThreadCount(int threads);
+	int GetThreadCount() const { return m_pool->GetThreadCount(); }
+
+	// add the four original bricks, fieldBricks small bricks in rows
+	// and circles randomly placed small circles
+	void Populate(std::size_t circles, int fieldBricks);
+	// lay out count small bricks in rows across the window,
+	// alternating between reflective and destructable
+	void AddBrickField(int count);
+
+	// advance the world by one step
+	void Step();
+
+	Particles::Store& GetCircles() { return m_circles; }
+	const Particles::Store& GetCircles() const { return m_circles; }
+	std::vector<Brick>& GetBricks() { return m_bricks; }
+	const std::vector<Brick>& GetBricks() const { return m_bricks; }
+	std::uint64_t GetStepCount() const { return m_stepCount; }
+	const StepStats& GetStepStats() const { return m_stats; }
+
+	// true when two worlds hold exactly the same state
+	bool SameState(const Simulation& other) const;
+
+private:
+	// the velocity and position change of one circle contact, added
+	// to the second circle and taken from the first
+	struct ContactDelta
+	{
+		float x, y;
+		float vx, vy;
+	};
+
+	// results of one worker, merged in worker order
+	struct WorkerResults
+	{
+		std::vector<CollisionGrid::Pair> pairs;
+		std::vector<std::uint32_t> bounced;		// one entry per reflective hit
+		std::vector<std::uint32_t> destroyed;
+		std::size_t pairTests;
+		std::size_t contacts;
+		std::size_t brickTests;
+		float largestRadius;
+	};
+
+	Particles::Store m_circles;
+	std::vector<Brick> m_bricks;
+	Particles::Bounds m_bounds;
+	std::uint64_t m_stepCount;
+	StepStats m_stats;
+
+	std::unique_ptr<ThreadPool> m_pool;
+	std::vector<WorkerResults> m_workers;
+
+	// the broad phase, rebuilt every step
+	CollisionGrid m_circleGrid;
+	CollisionGrid m_brickGrid;
+	std::vector<float> m_brickX, m_brickY, m_brickExtent;
+	std::vector<std::uint32_t> m_brickIds;
+	std::vector<CollisionGrid::Pair> m_pairs;
+	std::vector<ContactDelta> m_deltas;
+
+	// the phases of a step
+	void CollideCircles();
+	void CollideBricks();
+	void ApplyBrickHits();
+
+	// one of the eight old directions, at the circle speed
+	void RandomVelocity(float& vx, float& vy);
+};
+
+// step the same world on one thread and on several threads, then
+// report whether the states match and the time per step of both
+bool RunThreadComparison(std::size_t circles, int fieldBricks, int steps, int threads);
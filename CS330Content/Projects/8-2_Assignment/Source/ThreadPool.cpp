@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+// threadpool.cpp
+// ============
+// a fixed set of worker threads that split a range of work into equal,
+// contiguous parts
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+/***********************************************************
+ *  ThreadPool()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ThreadPool::ThreadPool(int threads)
+{
+	if (threads <= 0)
+	{
+		threads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	m_threadCount = std::max(1, threads);
+	m_task = NULL;
+	m_count = 0;
+	m_generation = 0;
+	m_pending = 0;
+	m_stop = false;
+
+	for (int worker = 1; worker < m_threadCount; worker++)
+	{
+		m_threads.emplace_back(&ThreadPool::WorkerLoop, this, worker);
+	}
+}
+
+/***********************************************************
+ *  ~ThreadPool()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_startCondition.notify_all();
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+/***********************************************************
+ *  RunPart()
+ *
+ *  This method is used for running the share of one worker
+ *  of the current task.
+ ***********************************************************/
+void ThreadPool::RunPart(int worker)
+{
+	std::size_t first = m_count * worker / m_threadCount;
+	std::size_t end = m_count * (worker + 1) / m_threadCount;
+	if (first < end)
+	{
+		(*m_task)(first, end, worker);
+	}
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is used for waiting for a task, running the
+ *  worker's share and reporting back, until the pool stops.
+ ***********************************************************/
+void ThreadPool::WorkerLoop(int worker)
+{
+	unsigned int seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startCondition.wait(lock, [&]() { return m_stop || m_generation != seen; });
+			if (m_stop)
+			{
+				return;
+			}
+			seen = m_generation;
+		}
+
+		RunPart(worker);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_pending == 0)
+		{
+			m_doneCondition.notify_one();
+		}
+	}
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for running a task over a range of
+ *  indices, with the calling thread taking the first part.
+ ***********************************************************/
+void ThreadPool::ParallelFor(std::size_t count, const Task& task)
+{
+	if (m_threadCount == 1 || count < static_cast<std::size_t>(m_threadCount))
+	{
+		// too little work to share, the parts are the same anyway
+		for (int worker = 0; worker < m_threadCount; worker++)
+		{
+			std::size_t first = count * worker / m_threadCount;
+			std::size_t end = count * (worker + 1) / m_threadCount;
+			if (first < end)
+			{
+				task(first, end, worker);
+			}
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_count = count;
+		m_pending = m_threadCount - 1;
+		m_generation++;
+	}
+	m_startCondition.notify_all();
+
+	RunPart(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [&]() { return m_pending == 0; });
+	m_task = NULL;
+}
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// threadpool.h
+// ============
+// a fixed set of worker threads that split a range of work into equal,
+// contiguous parts
+//
+//  The calling thread takes the first part itself and waits for the
+//  rest, so a pool of one thread runs everything inline.  The split
+//  only depends on the range and the thread count, which lets callers
+//  keep per-worker results and merge them in worker order.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  ThreadPool
+ *
+ *  This class contains the code for running a task over a
+ *  range of indices on several threads.
+ ***********************************************************/
+class ThreadPool
+{
+public:
+	// the task gets [first, end) and the number of the worker
+	typedef std::function<void(std::size_t first, std::size_t end, int worker)> Task;
+
+	// constructor, threads counts the calling thread, and zero
+	// means one thread per hardware thread
+	explicit ThreadPool(int threads);
+	// destructor
+	~ThreadPool();
+
+	int GetThreadCount() const { return m_threadCount; }
+
+	// run the task on count indices and return when every part is
+	// done, worker w gets [count * w / threads, count * (w + 1) / threads)
+	void ParallelFor(std::size_t count, const Task& task);
+
+private:
+	int m_threadCount;
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_startCondition;
+	std::condition_variable m_doneCondition;
+	const Task* m_task;
+	std::size_t m_count;
+	unsigned int m_generation;
+	int m_pending;
+	bool m_stop;
+
+	// the loop of each extra thread
+	void WorkerLoop(int worker);
+	// run the part of one worker
+	void RunPart(int worker);
+};
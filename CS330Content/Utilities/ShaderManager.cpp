@@ -14,6 +14,51 @@ using namespace std;
 
 #include "ShaderManager.h"
 
+namespace
+{
+	// compile one shader stage from a GLSL file, returns 0 on failure
+	GLuint CompileShaderFile(GLenum shaderType, const char* file_path)
+	{
+		std::ifstream shaderStream(file_path, std::ios::in);
+		if (!shaderStream.is_open())
+		{
+			printf("Impossible to open %s.\n", file_path);
+			return 0;
+		}
+
+		std::stringstream sstr;
+		sstr << shaderStream.rdbuf();
+		std::string shaderCode = sstr.str();
+
+		printf("Compiling shader : %s...", file_path);
+		GLuint shaderID = glCreateShader(shaderType);
+		char const* sourcePointer = shaderCode.c_str();
+		glShaderSource(shaderID, 1, &sourcePointer, NULL);
+		glCompileShader(shaderID);
+
+		GLint result = GL_FALSE;
+		int infoLogLength = 0;
+		glGetShaderiv(shaderID, GL_COMPILE_STATUS, &result);
+		glGetShaderiv(shaderID, GL_INFO_LOG_LENGTH, &infoLogLength);
+		if (infoLogLength > 1)
+		{
+			std::vector<char> errorMessage(infoLogLength + 1);
+			glGetShaderInfoLog(shaderID, infoLogLength, NULL, &errorMessage[0]);
+			printf("\n%s\n", &errorMessage[0]);
+		}
+
+		if (GL_TRUE != result)
+		{
+			printf("failed\n");
+			glDeleteShader(shaderID);
+			return 0;
+		}
+
+		printf("success\n");
+		return shaderID;
+	}
+}
+
 /***********************************************************
  *  LoadShaders()
  *
@@ -116,4 +161,133 @@ GLuint ShaderManager::LoadShaders(const char * vertex_file_path,const char * fra
 	return ProgramID;
 }
 
+/***********************************************************
+ *  LoadTessellationShaders()
+ *
+ *  This method is called to load the shaders that subdivide
+ *  curved surface patches on the GPU.  The tessellation
+ *  program is optional, so a failure is reported and the
+ *  default program keeps being used.
+ ***********************************************************/
+GLuint ShaderManager::LoadTessellationShaders(
+	const char* vertex_file_path,
+	const char* control_file_path,
+	const char* evaluation_file_path,
+	const char* fragment_file_path)
+{
+	const GLenum shaderTypes[4] = {
+		GL_VERTEX_SHADER, GL_TESS_CONTROL_SHADER,
+		GL_TESS_EVALUATION_SHADER, GL_FRAGMENT_SHADER };
+	const char* shaderPaths[4] = {
+		vertex_file_path, control_file_path,
+		evaluation_file_path, fragment_file_path };
+
+	m_tessProgramID = 0;
+
+	GLuint shaderIDs[4] = { 0, 0, 0, 0 };
+	bool bCompiled = true;
+	for (int i = 0; (i < 4) && (true == bCompiled); ++i)
+	{
+		shaderIDs[i] = CompileShaderFile(shaderTypes[i], shaderPaths[i]);
+		bCompiled = (0 != shaderIDs[i]);
+	}
+
+	GLuint programID = 0;
+	if (true == bCompiled)
+	{
+		printf("Linking tessellation shader program...");
+		programID = glCreateProgram();
+		for (int i = 0; i < 4; ++i)
+		{
+			glAttachShader(programID, shaderIDs[i]);
+		}
+		glLinkProgram(programID);
+
+		GLint result = GL_FALSE;
+		int infoLogLength = 0;
+		glGetProgramiv(programID, GL_LINK_STATUS, &result);
+		glGetProgramiv(programID, GL_INFO_LOG_LENGTH, &infoLogLength);
+		if (infoLogLength > 1)
+		{
+			std::vector<char> errorMessage(infoLogLength + 1);
+			glGetProgramInfoLog(programID, infoLogLength, NULL, &errorMessage[0]);
+			printf("\n%s\n", &errorMessage[0]);
+		}
+
+		for (int i = 0; i < 4; ++i)
+		{
+			glDetachShader(programID, shaderIDs[i]);
+		}
+
+		if (GL_TRUE == result)
+		{
+			printf("success\n");
+		}
+		else
+		{
+			printf("failed\n");
+			glDeleteProgram(programID);
+			programID = 0;
+		}
+	}
+
+	for (int i = 0; i < 4; ++i)
+	{
+		if (0 != shaderIDs[i])
+		{
+			glDeleteShader(shaderIDs[i]);
+		}
+	}
+
+	m_tessProgramID = programID;
+	return programID;
+}
+
+/***********************************************************
+ *  LoadComputeShader()
+ *
+ *  This method is called to load the compute shader that
+ *  generates mesh data on the GPU.  The compute program is
+ *  optional, so a failure is reported and the meshes keep
+ *  being generated on the CPU.
+ ***********************************************************/
+GLuint ShaderManager::LoadComputeShader(const char* compute_file_path)
+{
+	m_computeProgramID = 0;
+
+	GLuint shaderID = CompileShaderFile(GL_COMPUTE_SHADER, compute_file_path);
+	if (0 == shaderID)
+	{
+		return 0;
+	}
+
+	printf("Linking compute shader program...");
+	GLuint programID = glCreateProgram();
+	glAttachShader(programID, shaderID);
+	glLinkProgram(programID);
+
+	GLint result = GL_FALSE;
+	int infoLogLength = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &result);
+	glGetProgramiv(programID, GL_INFO_LOG_LENGTH, &infoLogLength);
+	if (infoLogLength > 1)
+	{
+		std::vector<char> errorMessage(infoLogLength + 1);
+		glGetProgramInfoLog(programID, infoLogLength, NULL, &errorMessage[0]);
+		printf("\n%s\n", &errorMessage[0]);
+	}
+
+	glDetachShader(programID, shaderID);
+	glDeleteShader(shaderID);
 
+	if (GL_TRUE != result)
+	{
+		printf("failed\n");
+		glDeleteProgram(programID);
+		return 0;
+	}
+
+	printf("success\n");
+	m_computeProgramID = programID;
+	return programID;
+}
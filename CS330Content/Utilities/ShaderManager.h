@@ -15,11 +15,29 @@ class ShaderManager
 {
 public:
 	unsigned int m_programID;
+	// optional program that tessellates curved patches, every uniform
+	// value that is set is mirrored to it while it is loaded
+	unsigned int m_tessProgramID = 0;
+	// optional program that generates mesh data on the GPU
+	unsigned int m_computeProgramID = 0;
 	
 	GLuint LoadShaders(
 		const char* vertex_file_path, 
 		const char* fragment_file_path);
 
+	// requires OpenGL 4.1, returns 0 and leaves the tessellation
+	// program unloaded when the shaders fail to build
+	GLuint LoadTessellationShaders(
+		const char* vertex_file_path,
+		const char* control_file_path,
+		const char* evaluation_file_path,
+		const char* fragment_file_path);
+
+	// requires OpenGL 4.3, returns 0 and leaves the compute
+	// program unloaded when the shader fails to build
+	GLuint LoadComputeShader(
+		const char* compute_file_path);
+
 	// activate the shader
 	// ------------------------------------------------------------------------
 	inline void use()
@@ -27,77 +45,110 @@ public:
 		glUseProgram(m_programID);
 	}
 
+	// activate the tessellation shader
+	// ------------------------------------------------------------------------
+	inline void useTessellation()
+	{
+		glUseProgram(m_tessProgramID);
+	}
+
 	// utility uniform functions
 	// ------------------------------------------------------------------------
 	inline void setBoolValue(const std::string &name, bool value) const
 	{
 		glUniform1i(glGetUniformLocation(m_programID, name.c_str()), (int)value);
+		if (0 != m_tessProgramID)
+			glProgramUniform1i(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), (int)value);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setIntValue(const std::string &name, int value) const
 	{
 		glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+		if (0 != m_tessProgramID)
+			glProgramUniform1i(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), value);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setFloatValue(const std::string &name, float value) const
 	{
 		glUniform1f(glGetUniformLocation(m_programID, name.c_str()), value);
+		if (0 != m_tessProgramID)
+			glProgramUniform1f(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), value);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setVec2Value(const std::string &name, const glm::vec2 &value) const
 	{
 		glUniform2fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		if (0 != m_tessProgramID)
+			glProgramUniform2fv(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), 1, &value[0]);
 	}
 
 	inline void setVec2Value(const std::string &name, float x, float y) const
 	{
 		glUniform2f(glGetUniformLocation(m_programID, name.c_str()), x, y);
+		if (0 != m_tessProgramID)
+			glProgramUniform2f(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), x, y);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setVec3Value(const std::string &name, const glm::vec3 &value) const
 	{
 		glUniform3fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		if (0 != m_tessProgramID)
+			glProgramUniform3fv(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), 1, &value[0]);
 	}
 	inline void setVec3Value(const std::string &name, float x, float y, float z) const
 	{
 		glUniform3f(glGetUniformLocation(m_programID, name.c_str()), x, y, z);
+		if (0 != m_tessProgramID)
+			glProgramUniform3f(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), x, y, z);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setVec4Value(const std::string &name, const glm::vec4 &value) const
 	{
 		glUniform4fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		if (0 != m_tessProgramID)
+			glProgramUniform4fv(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), 1, &value[0]);
 	}
 	inline void setVec4Value(const std::string &name, float x, float y, float z, float w)
 	{
 		glUniform4f(glGetUniformLocation(m_programID, name.c_str()), x, y, z, w);
+		if (0 != m_tessProgramID)
+			glProgramUniform4f(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), x, y, z, w);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setMat2Value(const std::string &name, const glm::mat2 &mat) const
 	{
 		glUniformMatrix2fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		if (0 != m_tessProgramID)
+			glProgramUniformMatrix2fv(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setMat3Value(const std::string &name, const glm::mat3 &mat) const
 	{
 		glUniformMatrix3fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		if (0 != m_tessProgramID)
+			glProgramUniformMatrix3fv(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setMat4Value(const std::string &name, const glm::mat4 &mat) const
 	{
 		glUniformMatrix4fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+		if (0 != m_tessProgramID)
+			glProgramUniformMatrix4fv(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
 	}
 
 	// ------------------------------------------------------------------------
 	inline void setSampler2DValue(const std::string& name, const int &value) const
 	{
 		glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+		if (0 != m_tessProgramID)
+			glProgramUniform1i(m_tessProgramID, glGetUniformLocation(m_tessProgramID, name.c_str()), value);
 	}
 };
\ No newline at end of file
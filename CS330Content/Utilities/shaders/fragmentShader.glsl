@@ -35,12 +35,32 @@ uniform vec3 viewPosition;
 uniform vec2 UVscale = vec2(1.0f, 1.0f);
 uniform LightSource lightSources[TOTAL_LIGHTS];
 uniform Material material;
+// dithered fade between two levels of detail: the new level keeps
+// the pixels under lodFade and the old level keeps the rest
+uniform float lodFade = 1.0f;
+uniform bool bLodFadeComplement = false;
 
 // function prototypes
 vec3 CalcLightSource(LightSource light, vec3 lightNormal, vec3 vertexPosition, vec3 viewDirection);
 
 void main()
 {
+   if(lodFade < 1.0f)
+   {
+      // 4x4 ordered dither threshold of this pixel
+      const float bayer[16] = float[16](
+          0.0f,  8.0f,  2.0f, 10.0f,
+         12.0f,  4.0f, 14.0f,  6.0f,
+          3.0f, 11.0f,  1.0f,  9.0f,
+         15.0f,  7.0f, 13.0f,  5.0f);
+      ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+      float threshold = (bayer[pixel.y * 4 + pixel.x] + 0.5f) / 16.0f;
+      if((threshold < lodFade) == bLodFadeComplement)
+      {
+         discard;
+      }
+   }
+
    if(bUseLighting == true)
    {
       // properties
@@ -0,0 +1,9 @@
+#version 330 core
+in vec3 fragmentColor;
+
+out vec4 outFragmentColor;
+
+void main()
+{
+   outFragmentColor = vec4(fragmentColor, 1.0f);
+}
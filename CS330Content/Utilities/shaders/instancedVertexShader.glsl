@@ -0,0 +1,15 @@
+#version 330 core
+// shape mesh in unit size: a unit circle or a unit square
+layout (location = 0) in vec2 inVertexPosition;
+// one per instance: center, size (circle radius or square side), color
+layout (location = 1) in vec2 inInstanceCenter;
+layout (location = 2) in float inInstanceSize;
+layout (location = 3) in vec3 inInstanceColor;
+
+out vec3 fragmentColor;
+
+void main()
+{
+   gl_Position = vec4(inInstanceCenter + inVertexPosition * inInstanceSize, 0.0f, 1.0f);
+   fragmentColor = inInstanceColor;
+}
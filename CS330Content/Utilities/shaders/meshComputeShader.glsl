@@ -0,0 +1,134 @@
+#version 430 core
+// generate the interleaved vertices (position, normal, texture coords)
+// and triangle indices of a parametric shape directly into the mesh
+// buffers, with the same layout as RevolutionMeshes.cpp
+layout (local_size_x = 64) in;
+
+layout (std430, binding = 0) writeonly buffer VertexBuffer
+{
+   float vertices[];
+};
+
+layout (std430, binding = 1) writeonly buffer IndexBuffer
+{
+   uint indices[];
+};
+
+// shape ids, these must match ComputeMeshes.cpp
+#define SHAPE_TORUS 0
+#define SHAPE_FRUSTUM 1
+
+uniform int shape;
+uniform int segments;         // main segments or frustum segments
+uniform int tubeSegments;     // torus only
+uniform float mainRadius;     // torus only
+uniform float radius;         // torus tube radius or frustum top radius
+uniform bool bHasTop;         // frustum only
+
+const float PI = 3.14159265358979;
+
+void WriteVertex(uint vertex, vec3 position, vec3 normal, vec2 textureCoordinate)
+{
+   uint base = vertex * 8u;
+   vertices[base + 0u] = position.x;
+   vertices[base + 1u] = position.y;
+   vertices[base + 2u] = position.z;
+   vertices[base + 3u] = normal.x;
+   vertices[base + 4u] = normal.y;
+   vertices[base + 5u] = normal.z;
+   vertices[base + 6u] = textureCoordinate.x;
+   vertices[base + 7u] = textureCoordinate.y;
+}
+
+// angle of step i out of count, the last step wraps to exactly 0
+vec2 CircleAt(int i, int count)
+{
+   float angle = 2.0f * PI * float(i % count) / float(count);
+   return vec2(cos(angle), sin(angle));
+}
+
+// one invocation per vertex and per grid quad: (main + 1) * (tube + 1)
+// vertices, then main * tube quads of six indices in memory order
+void GenerateTorus(uint id)
+{
+   uint tubePoints = uint(tubeSegments + 1);
+   uint vertexCount = uint(segments + 1) * tubePoints;
+   if (id < vertexCount)
+   {
+      int i = int(id / tubePoints);
+      int k = int(id % tubePoints);
+      vec2 main = CircleAt(i, segments);
+      vec2 tube = CircleAt(k, tubeSegments);
+      float radial = mainRadius + radius * tube.x;
+      WriteVertex(id,
+         vec3(radial * main, radius * tube.y),
+         vec3(tube.x * main, tube.y),
+         vec2(float(i) / float(segments), float(k) / float(tubeSegments)));
+   }
+
+   uint quadCount = uint(segments * tubeSegments);
+   if (id < quadCount)
+   {
+      uint o = id / uint(tubeSegments);
+      uint p = id % uint(tubeSegments);
+      uint a = o * tubePoints + p;
+      uint b = a + tubePoints;
+      uint base = id * 6u;
+      indices[base + 0u] = a;
+      indices[base + 1u] = b;
+      indices[base + 2u] = a + 1u;
+      indices[base + 3u] = a + 1u;
+      indices[base + 4u] = b;
+      indices[base + 5u] = b + 1u;
+   }
+}
+
+// one invocation per vertex: the bottom rim, the top rim, then the
+// sides as (top, bottom) pairs for a triangle strip
+void GenerateFrustum(uint id)
+{
+   uint topStart = uint(segments);
+   uint sideStart = topStart + (bHasTop ? uint(segments) : 0u);
+   uint vertexCount = sideStart + 2u * uint(segments + 1);
+   if (id >= vertexCount)
+   {
+      return;
+   }
+
+   if (id < sideStart)
+   {
+      // the caps use a disc texture mapping
+      bool bTop = (id >= topStart);
+      vec2 rim = CircleAt(int(bTop ? id - topStart : id), segments);
+      float capRadius = bTop ? radius : 1.0f;
+      WriteVertex(id,
+         vec3(capRadius * rim.x, bTop ? 1.0f : 0.0f, -capRadius * rim.y),
+         vec3(0.0f, bTop ? 1.0f : -1.0f, 0.0f),
+         vec2(0.5f - 0.5f * rim.y, 0.5f + 0.5f * rim.x));
+      return;
+   }
+
+   int j = int((id - sideStart) / 2u);
+   bool bTop = ((id - sideStart) % 2u) == 0u;
+   vec2 rim = CircleAt(j, segments);
+   float slope = 1.0f - radius;
+   float normalScale = 1.0f / sqrt(1.0f + slope * slope);
+   float sideRadius = bTop ? radius : 1.0f;
+   WriteVertex(id,
+      vec3(sideRadius * rim.x, bTop ? 1.0f : 0.0f, -sideRadius * rim.y),
+      vec3(normalScale * rim.x, slope * normalScale, -normalScale * rim.y),
+      vec2(float(j) / float(segments), bTop ? 1.0f : 0.0f));
+}
+
+void main()
+{
+   uint id = gl_GlobalInvocationID.x;
+   if (shape == SHAPE_TORUS)
+   {
+      GenerateTorus(id);
+   }
+   else
+   {
+      GenerateFrustum(id);
+   }
+}
@@ -0,0 +1,18 @@
+#version 330 core
+in vec2 fragmentLocalPosition;
+in vec3 fragmentColor;
+
+out vec4 outFragmentColor;
+
+void main()
+{
+   // signed distance to the circle edge in radius units, the screen
+   // space derivative turns it into a one pixel wide coverage ramp
+   float distance = length(fragmentLocalPosition) - 1.0f;
+   float coverage = clamp(0.5f - distance / fwidth(distance), 0.0f, 1.0f);
+   if (coverage <= 0.0f)
+   {
+      discard;
+   }
+   outFragmentColor = vec4(fragmentColor, coverage);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+// corner of the quad around a circle, from (-1, -1) to (1, 1)
+layout (location = 0) in vec2 inVertexPosition;
+// one per instance: center, radius, color
+layout (location = 1) in vec2 inInstanceCenter;
+layout (location = 2) in float inInstanceSize;
+layout (location = 3) in vec3 inInstanceColor;
+
+out vec2 fragmentLocalPosition;
+out vec3 fragmentColor;
+
+uniform vec2 viewportSize = vec2(480.0f, 480.0f);
+
+void main()
+{
+   // grow the quad by one pixel so the anti-aliased edge of tiny
+   // circles is not clipped by the quad
+   vec2 pixel = 2.0f / viewportSize;
+   vec2 extent = vec2(inInstanceSize) + pixel;
+   gl_Position = vec4(inInstanceCenter + inVertexPosition * extent, 0.0f, 1.0f);
+   fragmentLocalPosition = inVertexPosition * extent / inInstanceSize;
+   fragmentColor = inInstanceColor;
+}
@@ -0,0 +1,96 @@
+#version 440 core
+layout (vertices = 4) out;
+
+in vec4 controlPatchCoordinate[];
+out vec4 evaluationPatchCoordinate[];
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec2 viewportSize = vec2(1000.0f, 800.0f);
+uniform float tessPixelsPerEdge = 8.0f;
+
+// shape ids, these must match ShapeMeshes.cpp
+#define SHAPE_SPHERE 0
+#define SHAPE_TORUS 1
+#define SHAPE_FRUSTUM_SIDE 2
+#define SHAPE_FRUSTUM_BOTTOM 3
+#define SHAPE_FRUSTUM_TOP 4
+
+const float PI = 3.14159265358979;
+const float MAX_TESS_LEVEL = 64.0f;
+
+// position on the analytic surface for a parameter domain point
+vec3 SurfacePosition(vec4 p)
+{
+   int shape = int(p.z + 0.5f);
+   // wrap the seam so both sides of it evaluate the exact same position
+   float turn = (p.x >= 1.0f) ? 0.0f : p.x;
+
+   if (shape == SHAPE_SPHERE)
+   {
+      float azimuth = 2.0f * PI * turn - PI;
+      float polar = PI * (1.0f - p.y);
+      return vec3(sin(polar) * sin(azimuth), cos(polar), sin(polar) * cos(azimuth));
+   }
+   if (shape == SHAPE_TORUS)
+   {
+      float mainAngle = 2.0f * PI * turn;
+      float tubeAngle = 2.0f * PI * ((p.y >= 1.0f) ? 0.0f : p.y);
+      float radial = 1.0f + p.w * cos(tubeAngle);
+      return vec3(radial * cos(mainAngle), radial * sin(mainAngle), p.w * sin(tubeAngle));
+   }
+
+   float angle = 2.0f * PI * turn;
+   vec2 rim = vec2(cos(angle), -sin(angle));
+   if (shape == SHAPE_FRUSTUM_SIDE)
+   {
+      float radius = mix(1.0f, p.w, p.y);
+      return vec3(rim.x * radius, p.y, rim.y * radius);
+   }
+   if (shape == SHAPE_FRUSTUM_BOTTOM)
+   {
+      return vec3(rim.x * p.y, 0.0f, rim.y * p.y);
+   }
+   return vec3(rim.x * p.y * p.w, 1.0f, rim.y * p.y * p.w);
+}
+
+// window position in pixels of a point on the surface
+vec2 ToScreen(vec4 p)
+{
+   vec4 clip = projection * view * model * vec4(SurfacePosition(p), 1.0f);
+   return (clip.xy / max(clip.w, 0.0001f)) * 0.5f * viewportSize;
+}
+
+// tessellation level for one patch edge from its projected length, measured
+// through the edge midpoint so curved edges are not underestimated
+float EdgeLevel(vec4 a, vec4 b)
+{
+   vec2 screenA = ToScreen(a);
+   vec2 screenMid = ToScreen(0.5f * (a + b));
+   vec2 screenB = ToScreen(b);
+   float pixels = length(screenMid - screenA) + length(screenB - screenMid);
+   return clamp(pixels / tessPixelsPerEdge, 1.0f, MAX_TESS_LEVEL);
+}
+
+void main()
+{
+   evaluationPatchCoordinate[gl_InvocationID] = controlPatchCoordinate[gl_InvocationID];
+
+   if (gl_InvocationID == 0)
+   {
+      // corners: 0 = (u0, v0), 1 = (u1, v0), 2 = (u1, v1), 3 = (u0, v1)
+      vec4 p0 = controlPatchCoordinate[0];
+      vec4 p1 = controlPatchCoordinate[1];
+      vec4 p2 = controlPatchCoordinate[2];
+      vec4 p3 = controlPatchCoordinate[3];
+
+      gl_TessLevelOuter[0] = EdgeLevel(p0, p3);
+      gl_TessLevelOuter[1] = EdgeLevel(p0, p1);
+      gl_TessLevelOuter[2] = EdgeLevel(p1, p2);
+      gl_TessLevelOuter[3] = EdgeLevel(p3, p2);
+
+      gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+      gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+   }
+}
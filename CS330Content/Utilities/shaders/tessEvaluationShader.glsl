@@ -0,0 +1,83 @@
+#version 440 core
+layout (quads, equal_spacing, ccw) in;
+
+in vec4 evaluationPatchCoordinate[];
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// shape ids, these must match ShapeMeshes.cpp
+#define SHAPE_SPHERE 0
+#define SHAPE_TORUS 1
+#define SHAPE_FRUSTUM_SIDE 2
+#define SHAPE_FRUSTUM_BOTTOM 3
+#define SHAPE_FRUSTUM_TOP 4
+
+const float PI = 3.14159265358979;
+
+// position, normal and texture coordinate on the analytic surface
+void EvaluateSurface(vec4 p, out vec3 position, out vec3 normal, out vec2 textureCoordinate)
+{
+   int shape = int(p.z + 0.5f);
+   // wrap the seam so both sides of it evaluate the exact same position
+   float turn = (p.x >= 1.0f) ? 0.0f : p.x;
+   textureCoordinate = p.xy;
+
+   if (shape == SHAPE_SPHERE)
+   {
+      float azimuth = 2.0f * PI * turn - PI;
+      float polar = PI * (1.0f - p.y);
+      position = vec3(sin(polar) * sin(azimuth), cos(polar), sin(polar) * cos(azimuth));
+      normal = position;
+      return;
+   }
+   if (shape == SHAPE_TORUS)
+   {
+      float mainAngle = 2.0f * PI * turn;
+      float tubeAngle = 2.0f * PI * ((p.y >= 1.0f) ? 0.0f : p.y);
+      vec2 main = vec2(cos(mainAngle), sin(mainAngle));
+      float radial = 1.0f + p.w * cos(tubeAngle);
+      position = vec3(radial * main, p.w * sin(tubeAngle));
+      normal = vec3(cos(tubeAngle) * main, sin(tubeAngle));
+      return;
+   }
+
+   float angle = 2.0f * PI * turn;
+   vec2 rim = vec2(cos(angle), -sin(angle));
+   if (shape == SHAPE_FRUSTUM_SIDE)
+   {
+      float radius = mix(1.0f, p.w, p.y);
+      position = vec3(rim.x * radius, p.y, rim.y * radius);
+      normal = normalize(vec3(rim.x, 1.0f - p.w, rim.y));
+      return;
+   }
+
+   // the caps use a disc texture mapping
+   float radius = (shape == SHAPE_FRUSTUM_BOTTOM) ? p.y : p.y * p.w;
+   position = vec3(rim.x * radius, (shape == SHAPE_FRUSTUM_BOTTOM) ? 0.0f : 1.0f, rim.y * radius);
+   normal = vec3(0.0f, (shape == SHAPE_FRUSTUM_BOTTOM) ? -1.0f : 1.0f, 0.0f);
+   textureCoordinate = vec2(0.5f + 0.5f * rim.y * p.y, 0.5f + 0.5f * rim.x * p.y);
+}
+
+void main()
+{
+   // bilinear interpolation of the patch corners in the parameter domain
+   vec4 bottom = mix(evaluationPatchCoordinate[0], evaluationPatchCoordinate[1], gl_TessCoord.x);
+   vec4 top = mix(evaluationPatchCoordinate[3], evaluationPatchCoordinate[2], gl_TessCoord.x);
+   vec4 p = mix(bottom, top, gl_TessCoord.y);
+
+   vec3 position;
+   vec3 normal;
+   vec2 textureCoordinate;
+   EvaluateSurface(p, position, normal, textureCoordinate);
+
+   fragmentPosition = vec3(model * vec4(position, 1.0f));
+   gl_Position = projection * view * model * vec4(position, 1.0f);
+   fragmentVertexNormal = normal;
+   fragmentTextureCoordinate = textureCoordinate;
+}
@@ -0,0 +1,11 @@
+#version 440 core
+// patch corner in the parameter domain of the curved primitive:
+// x = u, y = v, z = shape id, w = shape parameter
+layout (location = 0) in vec4 inPatchCoordinate;
+
+out vec4 controlPatchCoordinate;
+
+void main()
+{
+   controlPatchCoordinate = inPatchCoordinate;
+}